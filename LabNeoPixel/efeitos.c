@@ -4,162 +4,270 @@
 #include "testes_cores.h"
 #include <stdlib.h> 
 
-
-// Acende todos os LEDs de uma linha
-void acenderFileira(uint8_t y, uint8_t r, uint8_t g, uint8_t b) {
-    for (uint x = 0; x < NUM_COLUNAS; x++) {
-        uint index = getLEDIndex(x, y);
-        npSetLED(index, r, g, b);
+// Cada efeito é um gerador de quadros sem estado: o quadro 'passo' é
+// desenhado do zero na camada do efeito, e o motor abaixo decide quando chamá-lo.
+// Nenhum efeito bloqueia; o laço principal chama efeitoServico() e o
+// executor cíclico mantém seu ritmo enquanto a animação roda.
+
+// === Motor de efeitos ===
+// Um efeito por camada (ex.: a piscada de alerta sobre um efeito de
+// demonstração). Cada gerador desenha na sua camada, ativa enquanto o
+// efeito dura; o quadro composto é enviado por quem chama npWrite()
+// (a Tarefa 4), uma vez por quadro do executor.
+typedef struct {
+    efeito_quadro_t quadro;
+    efeito_param_t param;
+    uint16_t passo;
+    absolute_time_t prazo;
+} efeito_estado_t;
+
+static efeito_estado_t efeitos[NP_CAMADAS];
+
+// Desenha o quadro 'passo' do efeito da camada; false quando ele termina
+static bool efeitoDesenhar(np_camada_t camada) {
+    efeito_estado_t *e = &efeitos[camada];
+    np_camada_t anterior = npGetCamada();
+    npSetCamada(camada);
+    uint32_t duracao_ms = e->quadro(e->passo++, &e->param);
+    npSetCamada(anterior);
+
+    if (duracao_ms == 0) {
+        e->quadro = NULL;
+        npAtivarCamada(camada, false);
+        return false;
     }
-    npWrite();
+
+    // Prazos absolutos: atrasos de um quadro não se acumulam nos seguintes
+    e->prazo = delayed_by_ms(e->prazo, duracao_ms);
+    return true;
 }
 
-// Acende todos os LEDs de uma coluna
-void acenderColuna(uint8_t x, uint8_t r, uint8_t g, uint8_t b) {
-    for (uint y = 0; y < NUM_LINHAS; y++) {
-        uint index = getLEDIndex(x, y);
-        npSetLED(index, r, g, b);
+void efeitoIniciarNaCamada(np_camada_t camada, efeito_quadro_t quadro,
+                           uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    if (camada >= NP_CAMADAS) return;
+    efeito_estado_t *e = &efeitos[camada];
+    e->param = (efeito_param_t){ .r = r, .g = g, .b = b, .delay_ms = delay_ms };
+    e->quadro = quadro;
+    e->passo = 0;
+    e->prazo = get_absolute_time();
+    npAtivarCamada(camada, true);
+    efeitoDesenhar(camada);  // Primeiro quadro sem esperar
+}
+
+void efeitoIniciar(efeito_quadro_t quadro, uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    efeitoIniciarNaCamada(NP_CAMADA_EFEITO, quadro, r, g, b, delay_ms);
+}
+
+void efeitoParar(void) {
+    for (int c = 0; c < NP_CAMADAS; c++) {
+        if (!efeitos[c].quadro) continue;
+        efeitos[c].quadro = NULL;
+        npAtivarCamada((np_camada_t)c, false);
     }
-    npWrite();
 }
 
-// Preenche a matriz em espiral do canto superior esquerdo ao centro
-void efeitoEspiral(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
-    const uint8_t ordem_espiral[25][2] = {
-        {0,0},{1,0},{2,0},{3,0},{4,0},
-        {4,1},{4,2},{4,3},{4,4},
-        {3,4},{2,4},{1,4},{0,4},
-        {0,3},{0,2},{0,1},
-        {1,1},{2,1},{3,1},
-        {3,2},{3,3},
-        {2,3},{1,3},
-        {1,2},{2,2}
-    };
+bool efeitoAtivo(void) {
+    for (int c = 0; c < NP_CAMADAS; c++) {
+        if (efeitos[c].quadro) return true;
+    }
+    return false;
+}
 
-    npClear();
-    for (uint i = 0; i < 25; ++i) {
-        uint x = ordem_espiral[i][0];
-        uint y = ordem_espiral[i][1];
-        uint index = getLEDIndex(x, y);
-        npSetLED(index, r, g, b);
-        npWrite();
-        sleep_ms(delay_ms);
+// Prazo do próximo quadro, para quem dorme entre eventos
+absolute_time_t efeitoProximoPrazo(void) {
+    absolute_time_t prazo = at_the_end_of_time;
+    for (int c = 0; c < NP_CAMADAS; c++) {
+        if (efeitos[c].quadro && absolute_time_diff_us(efeitos[c].prazo, prazo) > 0) {
+            prazo = efeitos[c].prazo;
+        }
     }
+    return prazo;
 }
 
-// Efeito de onda vertical com brilho suavizado por linha
-void efeitoOndaVertical(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
-    for (int fase = 0; fase < NUM_LINHAS + 3; ++fase) {
-        npClear();
-        for (int y = 0; y < NUM_LINHAS; ++y) {
-            float intensidade = 1.0f - 0.25f * abs(fase - y);
-            if (intensidade < 0) intensidade = 0;
-
-            for (int x = 0; x < NUM_COLUNAS; ++x) {
-                uint index = getLEDIndex(x, y);
-                npSetLED(index, r * intensidade, g * intensidade, b * intensidade);
-            }
+// Desenha o próximo quadro de cada efeito cujo prazo chegou; retorna o
+// prazo mais próximo (at_the_end_of_time quando não há efeito ativo)
+absolute_time_t efeitoPasso(absolute_time_t agora) {
+    for (int c = 0; c < NP_CAMADAS; c++) {
+        const efeito_estado_t *e = &efeitos[c];
+        if (e->quadro && absolute_time_diff_us(agora, e->prazo) <= 0) {
+            efeitoDesenhar((np_camada_t)c);
         }
-        npWrite();
-        sleep_ms(delay_ms);
     }
+    return efeitoProximoPrazo();
 }
 
-// Preenche a matriz em espiral do canto superior esquerdo ao centro, inversa.
-void efeitoEspiralInversa(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
-    const uint8_t ordem_espiral[25][2] = {
-        {2,2},{1,2},{1,3},{2,3},{3,3},
-        {3,2},{3,1},{2,1},{1,1},
-        {0,1},{0,2},{0,3},{0,4},
-        {1,4},{2,4},{3,4},
-        {4,4},{4,3},{4,2},
-        {4,1},{4,0},
-        {3,0},{2,0},
-        {1,0},{0,0}
-    };
+// Chamada a cada quadro do executor; retorna true quando o último efeito termina
+bool efeitoServico(void) {
+    if (!efeitoAtivo()) return false;
+    efeitoPasso(get_absolute_time());
+    return !efeitoAtivo();
+}
 
-    npClear();
-    for (uint i = 0; i < 25; ++i) {
-        uint x = ordem_espiral[i][0];
-        uint y = ordem_espiral[i][1];
-        uint index = getLEDIndex(x, y);
-        npSetLED(index, r, g, b);
+// Executa um efeito inteiro na camada de efeitos, dormindo entre os quadros
+void efeitoExecutar(efeito_quadro_t quadro, uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    const efeito_estado_t *e = &efeitos[NP_CAMADA_EFEITO];
+    efeitoIniciar(quadro, r, g, b, delay_ms);
+    npWrite();
+    while (e->quadro) {
+        sleep_until(e->prazo);
+        efeitoPasso(get_absolute_time());
         npWrite();
-        sleep_ms(delay_ms);
     }
 }
 
+// === Primitivas ===
 
-//Onda com efeito vertical brilho
-void efeitoOndaVerticalBrilho(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
-    for (uint8_t passo = 0; passo < NUM_LINHAS; ++passo) {
-        npClear();
+static void preencherFileira(uint y, uint8_t r, uint8_t g, uint8_t b) {
+    npSetFileira(y, 0, NUM_COLUNAS, r, g, b);
+}
 
-        for (uint8_t y = 0; y <= passo; ++y) {
-            // Brilho progressivo proporcional à linha atual
-            float brilho = ((float)(y + 1)) / NUM_LINHAS;
+static void preencherColuna(uint x, uint8_t r, uint8_t g, uint8_t b) {
+    npSetColuna(x, 0, NUM_LINHAS, r, g, b);
+}
 
-            for (uint8_t x = 0; x < NUM_COLUNAS; ++x) {
-                uint index = getLEDIndex(x, y);
-                npSetLED(index, r * brilho, g * brilho, b * brilho);
-            }
-        }
+// Acende todos os LEDs de uma linha
+void acenderFileira(uint y, uint8_t r, uint8_t g, uint8_t b) {
+    preencherFileira(y, r, g, b);
+    npWrite();
+}
 
-        npWrite();
-        sleep_ms(delay_ms);
+// Acende todos os LEDs de uma coluna
+void acenderColuna(uint x, uint8_t r, uint8_t g, uint8_t b) {
+    preencherColuna(x, r, g, b);
+    npWrite();
+}
+
+// === Geradores de quadros ===
+
+// Preenche a matriz em espiral do canto superior esquerdo ao centro
+uint32_t quadroEspiral(uint16_t passo, const efeito_param_t *p) {
+    if (passo >= LED_COUNT) return 0;
+    npClear();
+    for (uint i = 0; i <= passo; ++i) {
+        npSetLED(np_espiral[i], p->r, p->g, p->b);
     }
+    return p->delay_ms;
 }
 
+// Preenche a matriz em espiral do centro ao canto superior esquerdo
+uint32_t quadroEspiralInversa(uint16_t passo, const efeito_param_t *p) {
+    if (passo >= LED_COUNT) return 0;
+    npClear();
+    for (uint i = 0; i <= passo; ++i) {
+        npSetLED(np_espiral[LED_COUNT - 1 - i], p->r, p->g, p->b);
+    }
+    return p->delay_ms;
+}
 
-void efeitoFileirasColoridas(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
-    for (uint8_t y = 0; y < NUM_LINHAS; ++y) {
-        npClear();
+// Efeito de onda vertical com brilho suavizado por linha
+uint32_t quadroOndaVertical(uint16_t passo, const efeito_param_t *p) {
+    int fase = passo;
+    if (fase >= NUM_LINHAS + 3) return 0;
 
-        float brilho = ((float)(y + 1)) / NUM_LINHAS;
+    npClear();
+    for (int y = 0; y < NUM_LINHAS; ++y) {
+        // 100%, 75%, 50%, 25% conforme a distância até a frente da onda
+        int distancia = abs(fase - y);
+        uint8_t intensidade = distancia < 4 ? 255 - distancia * 64 : 0;
 
-        acenderFileira(y, r * brilho, g * brilho, b * brilho);
+        preencherFileira(y, npEscala(p->r, intensidade), npEscala(p->g, intensidade), npEscala(p->b, intensidade));
+    }
+    return p->delay_ms;
+}
 
-        npWrite();
-        sleep_ms(delay_ms);
+//Onda com efeito vertical brilho
+uint32_t quadroOndaVerticalBrilho(uint16_t passo, const efeito_param_t *p) {
+    if (passo >= NUM_LINHAS) return 0;
+
+    npClear();
+    for (uint y = 0; y <= passo; ++y) {
+        // Brilho progressivo proporcional à linha atual
+        uint8_t brilho = 255 * (y + 1) / NUM_LINHAS;
+
+        preencherFileira(y, npEscala(p->r, brilho), npEscala(p->g, brilho), npEscala(p->b, brilho));
     }
+    return p->delay_ms;
 }
 
-void efeitoFileirasColoridasReverso(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
-    for (int8_t y = NUM_LINHAS - 1; y >= 0; --y) {
-        npClear();
+uint32_t quadroFileirasColoridas(uint16_t passo, const efeito_param_t *p) {
+    if (passo >= NUM_LINHAS) return 0;
+    uint y = passo;
+    uint8_t brilho = 255 * (y + 1) / NUM_LINHAS;
 
-        float brilho = ((float)(NUM_LINHAS - y)) / NUM_LINHAS;
+    npClear();
+    preencherFileira(y, npEscala(p->r, brilho), npEscala(p->g, brilho), npEscala(p->b, brilho));
+    return p->delay_ms;
+}
 
-        acenderFileira(y, r * brilho, g * brilho, b * brilho);
+uint32_t quadroFileirasColoridasReverso(uint16_t passo, const efeito_param_t *p) {
+    if (passo >= NUM_LINHAS) return 0;
+    uint y = NUM_LINHAS - 1 - passo;
+    uint8_t brilho = 255 * (NUM_LINHAS - y) / NUM_LINHAS;
 
-        npWrite();
-        sleep_ms(delay_ms);
-    }
+    npClear();
+    preencherFileira(y, npEscala(p->r, brilho), npEscala(p->g, brilho), npEscala(p->b, brilho));
+    return p->delay_ms;
 }
 
+uint32_t quadroColunasColoridas(uint16_t passo, const efeito_param_t *p) {
+    if (passo >= NUM_COLUNAS) return 0;
+    uint x = passo;
+    uint8_t brilho = 255 * (x + 1) / NUM_COLUNAS;
 
-void efeitoColunasColoridas(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
-    for (uint8_t x = 0; x < NUM_COLUNAS; ++x) {
-        npClear();
+    npClear();
+    preencherColuna(x, npEscala(p->r, brilho), npEscala(p->g, brilho), npEscala(p->b, brilho));
+    return p->delay_ms;
+}
 
-        float brilho = ((float)(x + 1)) / NUM_COLUNAS;
+uint32_t quadroColunasColoridasReverso(uint16_t passo, const efeito_param_t *p) {
+    if (passo >= NUM_COLUNAS) return 0;
+    uint x = NUM_COLUNAS - 1 - passo;
+    uint8_t brilho = 255 * (NUM_COLUNAS - x) / NUM_COLUNAS;
 
-        acenderColuna(x, r * brilho, g * brilho, b * brilho);
+    npClear();
+    preencherColuna(x, npEscala(p->r, brilho), npEscala(p->g, brilho), npEscala(p->b, brilho));
+    return p->delay_ms;
+}
 
-        npWrite();
-        sleep_ms(delay_ms);
+// Pisca a matriz inteira uma vez: aceso por delay_ms, apagado por delay_ms
+uint32_t quadroPiscar(uint16_t passo, const efeito_param_t *p) {
+    switch (passo) {
+        case 0:  npSetAll(p->r, p->g, p->b); return p->delay_ms;
+        case 1:  npClear();                  return p->delay_ms;
+        default: return 0;
     }
 }
 
-void efeitoColunasColoridasReverso(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
-    for (int8_t x = NUM_COLUNAS - 1; x >= 0; --x) {
-        npClear();
+// === Versões bloqueantes ===
 
-        float brilho = ((float)(NUM_COLUNAS - x)) / NUM_COLUNAS;
+void efeitoEspiral(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    efeitoExecutar(quadroEspiral, r, g, b, delay_ms);
+}
 
-        acenderColuna(x, r * brilho, g * brilho, b * brilho);
+void efeitoOndaVertical(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    efeitoExecutar(quadroOndaVertical, r, g, b, delay_ms);
+}
 
-        npWrite();
-        sleep_ms(delay_ms);
-    }
+void efeitoEspiralInversa(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    efeitoExecutar(quadroEspiralInversa, r, g, b, delay_ms);
+}
+
+void efeitoOndaVerticalBrilho(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    efeitoExecutar(quadroOndaVerticalBrilho, r, g, b, delay_ms);
+}
+
+void efeitoFileirasColoridas(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    efeitoExecutar(quadroFileirasColoridas, r, g, b, delay_ms);
+}
+
+void efeitoFileirasColoridasReverso(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    efeitoExecutar(quadroFileirasColoridasReverso, r, g, b, delay_ms);
+}
+
+void efeitoColunasColoridas(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    efeitoExecutar(quadroColunasColoridas, r, g, b, delay_ms);
+}
+
+void efeitoColunasColoridasReverso(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms) {
+    efeitoExecutar(quadroColunasColoridasReverso, r, g, b, delay_ms);
 }
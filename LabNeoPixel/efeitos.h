@@ -1,12 +1,47 @@
 #ifndef EFEITOS_H
 #define EFEITOS_H
 
+#include <stdbool.h>
 #include <stdint.h>
-#include "LabNeoPixel/efeitos.h"
+#include "pico/stdlib.h"
+#include "neopixel_driver.h"
 
+// Parâmetros comuns dos efeitos
+typedef struct {
+    uint8_t r, g, b;
+    uint16_t delay_ms;
+} efeito_param_t;
 
-void acenderFileira(uint8_t y, uint8_t r, uint8_t g, uint8_t b);
-void acenderColuna(uint8_t y, uint8_t r, uint8_t g, uint8_t b);
+// Gerador de quadros: desenha o quadro 'passo' na camada do efeito (sem
+// npWrite) e retorna por quantos ms ele deve permanecer; 0 indica fim do efeito
+typedef uint32_t (*efeito_quadro_t)(uint16_t passo, const efeito_param_t *p);
+
+// Motor de efeitos não bloqueante (um efeito ativo por camada). Os quadros
+// só vão para a matriz no próximo npWrite()
+void efeitoIniciarNaCamada(np_camada_t camada, efeito_quadro_t quadro,
+                           uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms);
+void efeitoIniciar(efeito_quadro_t quadro, uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms);
+void efeitoParar(void);
+bool efeitoAtivo(void);
+absolute_time_t efeitoProximoPrazo(void);
+absolute_time_t efeitoPasso(absolute_time_t agora);
+bool efeitoServico(void);
+void efeitoExecutar(efeito_quadro_t quadro, uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms);
+
+// Geradores de quadros
+uint32_t quadroEspiral(uint16_t passo, const efeito_param_t *p);
+uint32_t quadroEspiralInversa(uint16_t passo, const efeito_param_t *p);
+uint32_t quadroOndaVertical(uint16_t passo, const efeito_param_t *p);
+uint32_t quadroOndaVerticalBrilho(uint16_t passo, const efeito_param_t *p);
+uint32_t quadroFileirasColoridas(uint16_t passo, const efeito_param_t *p);
+uint32_t quadroFileirasColoridasReverso(uint16_t passo, const efeito_param_t *p);
+uint32_t quadroColunasColoridas(uint16_t passo, const efeito_param_t *p);
+uint32_t quadroColunasColoridasReverso(uint16_t passo, const efeito_param_t *p);
+uint32_t quadroPiscar(uint16_t passo, const efeito_param_t *p);
+
+// Versões bloqueantes (executam o efeito inteiro)
+void acenderFileira(uint y, uint8_t r, uint8_t g, uint8_t b);
+void acenderColuna(uint x, uint8_t r, uint8_t g, uint8_t b);
 void efeitoEspiral(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms);
 void efeitoOndaVertical(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms);
 void efeitoEspiralInversa(uint8_t r, uint8_t g, uint8_t b, uint16_t delay_ms);
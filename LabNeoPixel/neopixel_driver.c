@@ -1,50 +1,342 @@
 #include "neopixel_driver.h"
+#include "hardware/dma.h"
+#include "dma_servico.h"
 #include "ws2818b.pio.h"
 
+// Tempo de um quadro de 'n' LEDs no fio: 24 bits a 800 kHz por LED, mais o
+// reset (latch)
+#define NP_BIT_NS       1250
+#define NP_RESET_US     300
+#define NP_QUADRO_US(n) (((n) * 24 * NP_BIT_NS) / 1000 + NP_RESET_US)
+// Após o fim do DMA ainda saem as palavras no FIFO de TX (unido: 8)
+#define NP_FIFO_PALAVRAS 8
+#define NP_CAUDA_US     ((NP_FIFO_PALAVRAS * 24 * NP_BIT_NS) / 1000 + NP_RESET_US)
+
+_Static_assert(NP_FITAS >= 1 && NP_FITAS <= 4, "uma fita por máquina de estados da PIO");
+
 npLED_t leds[LED_COUNT];
 PIO np_pio;
-int sm;
 
-void npInit(uint pin) {
-    uint offset = pio_add_program(pio0, &ws2818b_program);
-    np_pio = pio0;
-    sm = 0; // Usar SM 0 fixamente
-    pio_sm_claim(np_pio, sm);
-    ws2818b_program_init(np_pio, sm, offset, pin, 800000.f);
+// Programa ws2818b carregado uma vez na PIO, para todas as fitas
+static bool np_programa_carregado = false;
+static uint np_programa_offset;
+
+// Camadas desenhadas pelas tarefas; npSetLED/npSetAll/npClear escrevem na
+// camada selecionada (base por padrão)
+static npLED_t np_camadas[NP_CAMADAS][LED_COUNT];
+static bool np_ativa[NP_CAMADAS] = { [NP_CAMADA_BASE] = true };
+static bool np_transparente[NP_CAMADAS];
+static np_camada_t np_desenho = NP_CAMADA_BASE;
+
+// Uma palavra por LED: G nos bits 0-7, R em 8-15, B em 16-23. Com o
+// deslocamento à direita da máquina de estados, os bits saem na mesma
+// ordem de antes (G, R, B, cada byte a partir do bit 0).
+// A matriz é dividida em fitas de índices consecutivos; a fita k usa os
+// dois quadros (frente e trás) do seu trecho em np_palavras.
+static uint32_t np_palavras[2 * LED_COUNT];
+static np_strip_t np_fitas[NP_FITAS];
+static np_indice_t np_inicio[NP_FITAS + 1];   // Primeiro índice de cada fita
+static uint np_num_fitas = 0;
+
+// Controle de alterações: o quadro só é recomposto se uma camada mudou, e
+// só é retransmitido se o resultado mudou ou se a tabela de saída
+// (brilho/gama) foi refeita
+static bool np_sujo = true;
+static bool np_tabela_nova = true;
+
+// Correção de gama 2,2 (valores não nulos nunca viram 0)
+static const uint8_t np_gama[256] = {
+      0,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255
+};
+
+// Tabela aplicada no empacotamento: gama e brilho global juntos, refeita
+// apenas quando o brilho ou o uso de gama mudam
+static uint8_t np_saida[256];
+static uint8_t np_brilho = 255;
+static bool np_usar_gama = false;   // Desligada: as cores saem como antes da tabela (npSetGama)
+
+static void npRefazerTabela(void) {
+    for (uint i = 0; i < 256; ++i) {
+        uint v = np_usar_gama ? np_gama[i] : i;
+        np_saida[i] = (v * np_brilho + 127) / 255;
+    }
+    np_sujo = true;
+    np_tabela_nova = true;
+}
+
+// === Fitas ===
+
+// Conclusão do DMA de uma fita. Se o canal foi atrasado por outros usuários
+// do barramento, o quadro termina depois da estimativa feita no disparo;
+// a partir daqui o prazo do reset é contado do fim real.
+static void npDmaConcluido(uint canal, void *contexto) {
+    (void)canal;
+    np_strip_t *s = contexto;
+    s->fim_dma_us = time_us_32();
+}
+
+// Reserva uma máquina de estados e um canal DMA para a fita. 'quadros' tem
+// 2 × quantidade palavras (frente e trás). A máquina fica parada até
+// npStripsHabilitar(), para as fitas partirem juntas.
+void npStripIniciar(np_strip_t *s, uint pino, uint32_t *quadros, np_indice_t quantidade) {
+    if (!np_programa_carregado) {
+        np_pio = pio0;
+        np_programa_offset = pio_add_program(np_pio, &ws2818b_program);
+        np_programa_carregado = true;
+    }
+    s->pio = np_pio;
+    s->sm = (uint)pio_claim_unused_sm(np_pio, true);
+    s->pino = pino;
+    s->palavras[0] = quadros;
+    s->palavras[1] = quadros + quantidade;
+    s->quantidade = quantidade;
+    s->frente = 0;
+    s->quadro_us = NP_QUADRO_US((uint32_t)quantidade);
+    s->bytes_enviados = 0;
+    ws2818b_program_config(s->pio, s->sm, np_programa_offset, pino, 800000.f);
+
+    s->dma_canal = dma_servico_reservar("neopixel", DMA_SERVICO_LINHA_SAIDA, npDmaConcluido, s);
+    dma_channel_config cfg = dma_channel_get_default_config(s->dma_canal);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_32);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, pio_get_dreq(s->pio, s->sm, true));
+    dma_channel_configure(s->dma_canal, &cfg, &s->pio->txf[s->sm], s->palavras[0], quantidade, false);
+
+    s->liberado_em = get_absolute_time();
+    s->fim_dma_us = time_us_32() - NP_CAUDA_US;
+}
+
+// Liga as máquinas das fitas no mesmo ciclo de clock (divisores alinhados)
+void npStripsHabilitar(np_strip_t fitas[], uint n) {
+    uint32_t mascara = 0;
+    for (uint k = 0; k < n; ++k) mascara |= 1u << fitas[k].sm;
+    pio_enable_sm_mask_in_sync(np_pio, mascara);
+}
+
+// Indica se o quadro anterior ainda está sendo transmitido ou no tempo de reset
+bool npStripOcupado(const np_strip_t *s) {
+    return dma_channel_is_busy(s->dma_canal) || !time_reached(s->liberado_em) ||
+           time_us_32() - s->fim_dma_us < NP_CAUDA_US;
+}
+
+// Quadro de trás, livre para empacotar mesmo com o da frente no fio
+uint32_t *npStripTras(np_strip_t *s) {
+    return s->palavras[s->frente ^ 1];
+}
+
+// Espera as fitas terminarem o quadro anterior, troca frente e trás em todas
+// e dispara os canais juntos: o tempo total é o da fita mais longa. O
+// próximo quadro de cada fita só é liberado após a transmissão completa e o
+// tempo de reset dos LEDs.
+void npStripsEnviar(np_strip_t fitas[], uint n) {
+    for (uint k = 0; k < n; ++k) {
+        while (npStripOcupado(&fitas[k])) tight_loop_contents();
+    }
+    uint32_t mascara = 0;
+    for (uint k = 0; k < n; ++k) {
+        np_strip_t *s = &fitas[k];
+        s->frente ^= 1;
+        s->liberado_em = make_timeout_time_us(s->quadro_us);
+        dma_channel_set_read_addr(s->dma_canal, s->palavras[s->frente], false);
+        s->bytes_enviados += (uint32_t)s->quantidade * 3;
+        mascara |= 1u << s->dma_canal;
+    }
+    dma_start_channel_mask(mascara);
+}
+
+// === Matriz ===
+
+// Divide a matriz em 'n' fitas de índices consecutivos, uma por pino
+void npInitFitas(const uint *pinos, uint n) {
+    if (n < 1) n = 1;
+    if (n > NP_FITAS) n = NP_FITAS;
+    for (uint k = 0; k <= n; ++k) np_inicio[k] = (np_indice_t)(k * LED_COUNT / n);
+    for (uint k = 0; k < n; ++k) {
+        npStripIniciar(&np_fitas[k], pinos[k], &np_palavras[2 * np_inicio[k]],
+                       (np_indice_t)(np_inicio[k + 1] - np_inicio[k]));
+    }
+    np_num_fitas = n;
+    npStripsHabilitar(np_fitas, n);
+
+    npRefazerTabela();
     npClear();
 }
 
-void npWrite(void) {
-    for (uint i = 0; i < LED_COUNT; ++i) {
-        pio_sm_put_blocking(np_pio, sm, leds[i].G);
-        pio_sm_put_blocking(np_pio, sm, leds[i].R);
-        pio_sm_put_blocking(np_pio, sm, leds[i].B);
+// Matriz inteira em uma fita
+void npInit(uint pin) {
+    npInitFitas(&pin, 1);
+}
+
+bool npOcupado(void) {
+    for (uint k = 0; k < np_num_fitas; ++k) {
+        if (npStripOcupado(&np_fitas[k])) return true;
     }
+    return false;
 }
 
-void npWriteComBrilho(float brilho) {
+static bool npPreto(const npLED_t *p) {
+    return !(p->R | p->G | p->B);
+}
+
+// Compõe as camadas em leds[]; retorna true se algum pixel mudou
+static bool npCompor(void) {
+    bool mudou = false;
     for (uint i = 0; i < LED_COUNT; ++i) {
-        uint8_t r = leds[i].R * brilho;
-        uint8_t g = leds[i].G * brilho;
-        uint8_t b = leds[i].B * brilho;
-        pio_sm_put_blocking(np_pio, sm, g);
-        pio_sm_put_blocking(np_pio, sm, r);
-        pio_sm_put_blocking(np_pio, sm, b);
+        const npLED_t *p = &np_camadas[NP_CAMADA_BASE][i];
+        for (int c = NP_CAMADAS - 1; c > NP_CAMADA_BASE; --c) {
+            if (!np_ativa[c]) continue;
+            const npLED_t *q = &np_camadas[c][i];
+            if (np_transparente[c] && npPreto(q)) continue;
+            p = q;
+            break;
+        }
+        if (leds[i].R != p->R || leds[i].G != p->G || leds[i].B != p->B) {
+            leds[i] = *p;
+            mudou = true;
+        }
     }
+    return mudou;
 }
 
-void npSetLED(uint8_t index, uint8_t r, uint8_t g, uint8_t b) {
-    if (index < LED_COUNT) {
-        leds[index].R = r;
-        leds[index].G = g;
-        leds[index].B = b;
+// Fim do quadro: compõe as camadas, empacota no quadro de trás de cada fita
+// (enquanto o da frente ainda pode estar no fio) e envia todas juntas. Um
+// envio por chamada, e nenhum se o quadro composto não mudou.
+void npWrite(void) {
+    if (!np_sujo) return;  // Nenhuma camada mudou
+    np_sujo = false;
+    if (!npCompor() && !np_tabela_nova) return;
+    np_tabela_nova = false;
+
+    for (uint k = 0; k < np_num_fitas; ++k) {
+        uint32_t *tras = npStripTras(&np_fitas[k]);
+        const npLED_t *origem = &leds[np_inicio[k]];
+        for (uint i = 0; i < np_fitas[k].quantidade; ++i) {
+            tras[i] = np_saida[origem[i].G] |
+                      ((uint32_t)np_saida[origem[i].R] << 8) |
+                      ((uint32_t)np_saida[origem[i].B] << 16);
+        }
     }
+    npStripsEnviar(np_fitas, np_num_fitas);
+}
+
+// Bytes no fio somados nas fitas da matriz, para os benchmarks
+uint32_t npBytesEnviados(void) {
+    uint32_t total = 0;
+    for (uint k = 0; k < np_num_fitas; ++k) total += np_fitas[k].bytes_enviados;
+    return total;
+}
+
+// Retransmite o quadro mesmo sem alterações (ex.: LEDs religados)
+void npWriteForcado(void) {
+    np_sujo = true;
+    np_tabela_nova = true;
+    npWrite();
+}
+
+// Camada em que npSetLED/npSetAll/npClear desenham
+void npSetCamada(np_camada_t camada) {
+    if (camada < NP_CAMADAS) np_desenho = camada;
+}
+
+np_camada_t npGetCamada(void) {
+    return np_desenho;
+}
+
+// Liga ou desliga uma sobreposição; a base fica sempre ativa
+void npAtivarCamada(np_camada_t camada, bool ativa) {
+    if (camada == NP_CAMADA_BASE || camada >= NP_CAMADAS || np_ativa[camada] == ativa) return;
+    np_ativa[camada] = ativa;
+    np_sujo = true;
+}
+
+// Com 'preto_transparente', os pixels apagados da camada mostram a de baixo
+void npSetTransparente(np_camada_t camada, bool preto_transparente) {
+    if (camada >= NP_CAMADAS || np_transparente[camada] == preto_transparente) return;
+    np_transparente[camada] = preto_transparente;
+    np_sujo = true;
+}
+
+// Define o brilho global (0-255); a tabela só é refeita se o valor mudar
+void npSetBrilho(uint8_t brilho) {
+    if (brilho == np_brilho) return;
+    np_brilho = brilho;
+    npRefazerTabela();
+}
+
+uint8_t npGetBrilho(void) {
+    return np_brilho;
+}
+
+// Liga/desliga a correção de gama da tabela de saída
+void npSetGama(bool ativa) {
+    if (ativa == np_usar_gama) return;
+    np_usar_gama = ativa;
+    npRefazerTabela();
+}
+
+// Mantida por compatibilidade: envia um quadro com o brilho dado, sem
+// alterar o global. O empacotamento termina dentro de npWrite(), então o
+// brilho anterior já pode voltar; o próximo npWrite() reenvia com ele.
+void npWriteComBrilho(float brilho) {
+    if (brilho < 0.0f) brilho = 0.0f;
+    if (brilho > 1.0f) brilho = 1.0f;
+    uint8_t anterior = np_brilho;
+    npSetBrilho((uint8_t)(brilho * 255.0f + 0.5f));
+    npWrite();
+    npSetBrilho(anterior);
+}
+
+// Escreve um pixel da camada de desenho; índice já validado
+static inline void npPintar(npLED_t *camada, np_indice_t index, uint8_t r, uint8_t g, uint8_t b) {
+    npLED_t *p = &camada[index];
+    if (p->R == r && p->G == g && p->B == b) return;
+    p->R = r;
+    p->G = g;
+    p->B = b;
+    np_sujo = true;
+}
+
+void npSetLED(np_indice_t index, uint8_t r, uint8_t g, uint8_t b) {
+    if (index < LED_COUNT) npPintar(np_camadas[np_desenho], index, r, g, b);
+}
+
+// Trecho de 'n' LEDs da linha y a partir da coluna x0, cortado na borda.
+// Os índices vêm direto da tabela: sem conta nem teste por pixel.
+void npSetFileira(uint y, uint x0, uint n, uint8_t r, uint8_t g, uint8_t b) {
+    if (y >= NUM_LINHAS || x0 >= NUM_COLUNAS) return;
+    if (n > NUM_COLUNAS - x0) n = NUM_COLUNAS - x0;
+    npLED_t *camada = np_camadas[np_desenho];
+    const np_indice_t *linha = &np_layout[y][x0];
+    for (uint i = 0; i < n; ++i) npPintar(camada, linha[i], r, g, b);
+}
+
+// Trecho de 'n' LEDs da coluna x a partir da linha y0, cortado na borda
+void npSetColuna(uint x, uint y0, uint n, uint8_t r, uint8_t g, uint8_t b) {
+    if (x >= NUM_COLUNAS || y0 >= NUM_LINHAS) return;
+    if (n > NUM_LINHAS - y0) n = NUM_LINHAS - y0;
+    npLED_t *camada = np_camadas[np_desenho];
+    for (uint i = 0; i < n; ++i) npPintar(camada, np_layout[y0 + i][x], r, g, b);
 }
 
 void npSetAll(uint8_t r, uint8_t g, uint8_t b) {
-    for (uint i = 0; i < LED_COUNT; ++i) {
-        npSetLED(i, r, g, b);
-    }
+    npLED_t *camada = np_camadas[np_desenho];
+    for (uint i = 0; i < LED_COUNT; ++i) npPintar(camada, (np_indice_t)i, r, g, b);
 }
 
 void npClear(void) {
@@ -57,10 +349,3 @@ void liberar_maquina_pio(PIO pio, uint sm_id) {
         pio_sm_unclaim(pio, sm_id);
     }
 }
-
-uint getLEDIndex(uint x, uint y) {
-    if (x >= NUM_COLUNAS || y >= NUM_LINHAS) return 0;
-    uint linha_fisica = NUM_LINHAS - 1 - y;
-    uint base = linha_fisica * NUM_COLUNAS;
-    return (linha_fisica % 2 == 0) ? base + (NUM_COLUNAS - 1 - x) : base + x;
-}
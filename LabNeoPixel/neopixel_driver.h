@@ -1,13 +1,31 @@
 #ifndef NEOPIXEL_DRIVER_H
 #define NEOPIXEL_DRIVER_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "hardware/pio.h"
 
-#define LED_COUNT 25
 #define LED_PIN 7
+
+// Geometria da matriz (CMakeLists.txt: NP_COLUNAS e NP_LINHAS). A ligação
+// (canto de origem, sentido, serpentina) só entra na tabela np_layout,
+// gerada na compilação por tools/gerar_layout_matriz.py
+#ifndef NUM_COLUNAS
 #define NUM_COLUNAS 5
+#endif
+#ifndef NUM_LINHAS
 #define NUM_LINHAS 5
+#endif
+#define LED_COUNT (NUM_COLUNAS * NUM_LINHAS)
+
+// Fitas da matriz (CMakeLists.txt: NP_FITAS e NP_PINOS, até 4): a fita k
+// recebe o k-ésimo trecho de LED_COUNT / NP_FITAS índices consecutivos
+#ifndef NP_FITAS
+#define NP_FITAS 1
+#endif
+#ifndef NP_PINOS
+#define NP_PINOS LED_PIN
+#endif
 #define COR_APAGA   0
 #define COR_MIN     64
 #define COR_INTER   128
@@ -18,17 +36,79 @@ typedef struct {
     uint8_t G, R, B;
 } npLED_t;
 
+// Posição do LED na fita (até 65535 LEDs)
+typedef uint16_t np_indice_t;
+
+// (x, y) -> índice, x da esquerda para a direita e y de cima para baixo
+extern const np_indice_t np_layout[NUM_LINHAS][NUM_COLUNAS];
+// Índices em espiral horária do canto superior esquerdo ao centro
+extern const np_indice_t np_espiral[LED_COUNT];
+
+// Camadas do quadro, da mais baixa para a mais alta. npWrite() compõe as
+// camadas ativas em um único quadro: cada pixel vem da camada ativa mais
+// alta, exceto onde ela é transparente (preto com npSetTransparente).
+typedef enum {
+    NP_CAMADA_BASE,     // Cor da tendência (Tarefa 4); sempre ativa
+    NP_CAMADA_ALERTA,   // Sobreposição de alerta (piscada da Tarefa 5)
+    NP_CAMADA_EFEITO,   // Efeitos e testes
+    NP_CAMADAS
+} np_camada_t;
+
+// Uma fita WS2812: máquina de estados própria na PIO do programa ws2818b e
+// canal DMA próprio, lendo do quadro da frente enquanto o de trás é montado
+typedef struct {
+    PIO pio;
+    uint sm;
+    uint pino;
+    uint dma_canal;
+    uint32_t *palavras[2];          // Frente e trás, 'quantidade' palavras cada
+    np_indice_t quantidade;
+    uint frente;
+    uint32_t quadro_us;             // Quadro no fio, com o reset
+    absolute_time_t liberado_em;
+    volatile uint32_t fim_dma_us;   // time_us_32() no fim do DMA (callback)
+    uint32_t bytes_enviados;
+} np_strip_t;
+
+// Último quadro composto (antes de brilho e gama), como enviado à matriz
 extern npLED_t leds[LED_COUNT];
+
+// Escala um valor de cor por uma intensidade inteira (255 = 100%)
+static inline uint8_t npEscala(uint8_t valor, uint8_t intensidade) {
+    return (valor * intensidade + 127) / 255;
+}
 extern PIO np_pio;
-extern int sm;
+
+void npStripIniciar(np_strip_t *s, uint pino, uint32_t *quadros, np_indice_t quantidade);
+void npStripsHabilitar(np_strip_t fitas[], uint n);
+bool npStripOcupado(const np_strip_t *s);
+uint32_t *npStripTras(np_strip_t *s);
+void npStripsEnviar(np_strip_t fitas[], uint n);
 
 void npInit(uint pin);
+void npInitFitas(const uint *pinos, uint n);
 void npWrite(void);
+void npWriteForcado(void);
 void npWriteComBrilho(float brilho);
-void npSetLED(uint8_t index, uint8_t r, uint8_t g, uint8_t b);
+void npSetBrilho(uint8_t brilho);
+uint8_t npGetBrilho(void);
+void npSetGama(bool ativa);
+bool npOcupado(void);
+uint32_t npBytesEnviados(void);
+void npSetCamada(np_camada_t camada);
+np_camada_t npGetCamada(void);
+void npAtivarCamada(np_camada_t camada, bool ativa);
+void npSetTransparente(np_camada_t camada, bool preto_transparente);
+void npSetLED(np_indice_t index, uint8_t r, uint8_t g, uint8_t b);
+void npSetFileira(uint y, uint x0, uint n, uint8_t r, uint8_t g, uint8_t b);
+void npSetColuna(uint x, uint y0, uint n, uint8_t r, uint8_t g, uint8_t b);
 void npSetAll(uint8_t r, uint8_t g, uint8_t b);
 void npClear(void);
 void liberar_maquina_pio(PIO pio, uint sm);
-uint getLEDIndex(uint x, uint y);
+
+// Fora da matriz retorna 0, como antes da tabela
+static inline uint getLEDIndex(uint x, uint y) {
+    return (x < NUM_COLUNAS && y < NUM_LINHAS) ? np_layout[y][x] : 0;
+}
 
 #endif
\ No newline at end of file
@@ -0,0 +1,361 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: ajustes.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Implementação do shell de ajustes (ajustes.h).
+ *
+ *      Os parâmetros ficam em uma tabela indexada por enum,
+ *      com nome, unidade, faixa e passo, e um vetor de
+ *      valores. Cada parâmetro pertence a um grupo aplicado de
+ *      uma vez pelo seu dono; 'def' só marca o grupo como
+ *      pendente e ajustes_servico() o aplica quando o dono
+ *      puder recebê-lo.
+ *
+ *      A linha é montada em um buffer fixo, sem eco (a mesma
+ *      USB leva a telemetria binária); as respostas são linhas
+ *      de texto que os decodificadores já saltam.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "hardware/i2c.h"
+#include "ssd1306.h"
+#include "ssd1306_i2c.h"
+#include "tarefa1_temp.h"
+#include "tarefa3_tendencia.h"
+#include "calibracao.h"
+#include "ajustes.h"
+#include "fletcher16.h"
+
+#define LINHA_MAX        40
+#define LINHA_PRAZO_US   2000000   // Linha abandonada é descartada
+
+enum {
+    AJUSTE_CICLO,
+    AJUSTE_JANELA,
+    AJUSTE_TAXA,
+    AJUSTE_BLOCO,
+    AJUSTE_DECIMACAO,
+    AJUSTE_CANAIS,
+    AJUSTE_LIMIAR_ENTRADA,
+    AJUSTE_LIMIAR_SAIDA,
+    AJUSTE_I2C,
+    AJUSTE_OLED,
+    AJUSTE_MATRIZ,
+    AJUSTES_NUM
+};
+
+// Grupos aplicados juntos, cada um pelo seu dono
+enum {
+    GRUPO_AQUISICAO = 1u << 0,   // Próxima janela da Tarefa 1
+    GRUPO_LIMIARES  = 1u << 1,   // Histerese da Tarefa 3
+    GRUPO_I2C       = 1u << 2,   // Clock do barramento do OLED
+    GRUPO_PERIODOS  = 1u << 3,   // Tabela de tarefas (main.c)
+    GRUPOS_TODOS    = 0x0F
+};
+
+typedef struct {
+    const char *nome;
+    const char *unidade;
+    uint32_t minimo;
+    uint32_t maximo;
+    uint16_t passo;      // Valores arredondados para baixo a múltiplos
+    uint8_t grupo;
+} ajuste_t;
+
+static const ajuste_t tabela[AJUSTES_NUM] = {
+    [AJUSTE_CICLO]          = { "ciclo",          "ms",         100,  4000,   10, GRUPO_PERIODOS },
+    [AJUSTE_JANELA]         = { "janela",         "us",         TAREFA1_DURACAO_MIN_US, TAREFA1_DURACAO_MAX_US, 1, GRUPO_AQUISICAO },
+    [AJUSTE_TAXA]           = { "taxa",           "amostras/s", 1000, 500000, 1,  GRUPO_AQUISICAO },
+    [AJUSTE_BLOCO]          = { "bloco",          "amostras",   1,    TAREFA1_BLOCO_MAX, 1, GRUPO_AQUISICAO },
+    [AJUSTE_DECIMACAO]      = { "decimacao",      "amostras",   1,    0xFFFF, 1,  GRUPO_AQUISICAO },
+    [AJUSTE_CANAIS]         = { "canais",         "mascara",    1,    (1u << TAREFA1_CANAIS) - 1, 1, GRUPO_AQUISICAO },
+    [AJUSTE_LIMIAR_ENTRADA] = { "limiar_entrada", "mC/leitura", 1,    1000,   1,  GRUPO_LIMIARES },
+    [AJUSTE_LIMIAR_SAIDA]   = { "limiar_saida",   "mC/leitura", 0,    1000,   1,  GRUPO_LIMIARES },
+    [AJUSTE_I2C]            = { "i2c",            "kHz",        100,  1000,   1,  GRUPO_I2C },
+    [AJUSTE_OLED]           = { "oled",           "ms",         100,  5000,   10, GRUPO_PERIODOS },
+    [AJUSTE_MATRIZ]         = { "matriz",         "ms",         10,   1000,   10, GRUPO_PERIODOS },
+};
+
+typedef struct __attribute__((packed)) {
+    uint32_t magica;
+    uint16_t quantidade;
+    uint16_t verificacao;
+    uint32_t valores[AJUSTES_NUM];
+} perfil_t;
+
+_Static_assert(sizeof(perfil_t) <= FLASH_PAGE_SIZE, "perfil deve caber em uma página");
+
+static uint32_t valores[AJUSTES_NUM];
+static uint32_t padroes[AJUSTES_NUM];   // Valores de compilação
+static uint8_t pendentes = 0;           // Grupos alterados ainda não aplicados
+static ajustes_periodos_t aplicar_periodos;
+
+static char linha[LINHA_MAX + 1];
+static uint32_t n_linha = 0;
+static bool linha_longa = false;        // Excedeu o buffer: descarta até o fim
+static uint32_t ultimo_caractere_us;
+
+static bool flash_disponivel = false;
+static bool gravacao_pendente = false;
+static uint8_t pagina[FLASH_PAGE_SIZE];
+
+static bool perfil_valido(const perfil_t *p) {
+    if (p->magica != AJUSTES_MAGICA || p->quantidade != AJUSTES_NUM) return false;
+    if (p->verificacao != fletcher16(p->valores, sizeof(p->valores))) return false;
+    for (uint32_t i = 0; i < AJUSTES_NUM; i++) {
+        if (p->valores[i] < tabela[i].minimo || p->valores[i] > tabela[i].maximo) return false;
+    }
+    return p->valores[AJUSTE_LIMIAR_SAIDA] <= p->valores[AJUSTE_LIMIAR_ENTRADA];
+}
+
+static void aplicar_pendentes(void) {
+    if (pendentes & GRUPO_AQUISICAO) {
+        tarefa1_parametros_t p = {
+            .taxa_sps = valores[AJUSTE_TAXA],
+            .duracao_us = valores[AJUSTE_JANELA],
+            .bloco = (uint16_t)valores[AJUSTE_BLOCO],
+            .decimacao = (uint16_t)valores[AJUSTE_DECIMACAO],
+            .canais = (uint8_t)valores[AJUSTE_CANAIS],
+        };
+        if (tarefa1_agendar_configuracao(&p)) pendentes &= ~GRUPO_AQUISICAO;
+    }
+    if (pendentes & GRUPO_LIMIARES) {
+        tarefa3_definir_limiares(valores[AJUSTE_LIMIAR_ENTRADA] / 1000.0f,
+                                 valores[AJUSTE_LIMIAR_SAIDA] / 1000.0f);
+        pendentes &= ~GRUPO_LIMIARES;
+    }
+    // Trocar o divisor no meio de uma transação corromperia o quadro
+    if ((pendentes & GRUPO_I2C) && !ssd1306_async_busy()) {
+        i2c_set_baudrate(i2c1, valores[AJUSTE_I2C] * 1000);
+        pendentes &= ~GRUPO_I2C;
+    }
+    if (pendentes & GRUPO_PERIODOS) {
+        aplicar_periodos(valores[AJUSTE_CICLO], valores[AJUSTE_OLED], valores[AJUSTE_MATRIZ]);
+        pendentes &= ~GRUPO_PERIODOS;
+    }
+}
+
+void ajustes_iniciar(uint32_t ciclo_ms, uint32_t oled_ms, uint32_t matriz_ms,
+                     ajustes_periodos_t aplicar) {
+    aplicar_periodos = aplicar;
+
+    const tarefa1_parametros_t *p = tarefa1_parametros();
+    float entrada, saida;
+    tarefa3_limiares(&entrada, &saida);
+
+    padroes[AJUSTE_CICLO] = ciclo_ms;
+    padroes[AJUSTE_JANELA] = p->duracao_us;
+    padroes[AJUSTE_TAXA] = p->taxa_sps;
+    padroes[AJUSTE_BLOCO] = p->bloco;
+    padroes[AJUSTE_DECIMACAO] = p->decimacao;
+    padroes[AJUSTE_CANAIS] = p->canais;
+    padroes[AJUSTE_LIMIAR_ENTRADA] = (uint32_t)lroundf(entrada * 1000.0f);
+    padroes[AJUSTE_LIMIAR_SAIDA] = (uint32_t)lroundf(saida * 1000.0f);
+    padroes[AJUSTE_I2C] = ssd1306_i2c_clock;
+    padroes[AJUSTE_OLED] = oled_ms;
+    padroes[AJUSTE_MATRIZ] = matriz_ms;
+    memcpy(valores, padroes, sizeof(valores));
+
+    // A imagem do firmware não pode alcançar o setor do perfil
+    flash_disponivel = mapa_flash_livre(AJUSTES_FLASH_OFFSET);
+    if (!flash_disponivel) return;
+
+    const perfil_t *gravado = (const perfil_t *)(XIP_BASE + AJUSTES_FLASH_OFFSET);
+    if (perfil_valido(gravado)) {
+        memcpy(valores, gravado->valores, sizeof(valores));
+        pendentes = GRUPOS_TODOS;
+        aplicar_pendentes();
+    }
+}
+
+static int procurar(const char *nome) {
+    for (int i = 0; i < AJUSTES_NUM; i++) {
+        if (!strcmp(nome, tabela[i].nome)) return i;
+    }
+    return -1;
+}
+
+static void imprimir_ajuste(int i) {
+    printf("%s=%lu %s [%lu..%lu]%s\n", tabela[i].nome, (unsigned long)valores[i], tabela[i].unidade,
+           (unsigned long)tabela[i].minimo, (unsigned long)tabela[i].maximo,
+           (pendentes & tabela[i].grupo) ? " (pendente)" : "");
+}
+
+static void comando_ver(const char *nome) {
+    if (!nome) {
+        for (int i = 0; i < AJUSTES_NUM; i++) imprimir_ajuste(i);
+        return;
+    }
+    int i = procurar(nome);
+    if (i < 0) {
+        printf("erro: ajuste desconhecido '%s'\n", nome);
+        return;
+    }
+    imprimir_ajuste(i);
+}
+
+static void comando_def(const char *nome, const char *texto) {
+    int i = nome ? procurar(nome) : -1;
+    if (i < 0 || !texto) {
+        printf("erro: uso def <nome> <valor> (ver lista com 'ver')\n");
+        return;
+    }
+
+    char *fim;
+    unsigned long v = strtoul(texto, &fim, 0);   // Aceita 0x para a máscara de canais
+    if (*fim != '\0') {
+        printf("erro: valor invalido '%s'\n", texto);
+        return;
+    }
+    const ajuste_t *a = &tabela[i];
+    if (v < a->minimo) v = a->minimo;
+    if (v > a->maximo) v = a->maximo;
+    v -= v % a->passo;
+
+    // Histerese: a saída nunca acima da entrada
+    if (i == AJUSTE_LIMIAR_SAIDA && v > valores[AJUSTE_LIMIAR_ENTRADA]) v = valores[AJUSTE_LIMIAR_ENTRADA];
+    if (i == AJUSTE_LIMIAR_ENTRADA && valores[AJUSTE_LIMIAR_SAIDA] > v) valores[AJUSTE_LIMIAR_SAIDA] = v;
+
+    valores[i] = (uint32_t)v;
+    pendentes |= a->grupo;
+    aplicar_pendentes();
+    printf("ok ");
+    imprimir_ajuste(i);
+}
+
+static void comando_gravar(void) {
+    if (!flash_disponivel) {
+        printf("erro: setor do perfil ocupado pela imagem do firmware\n");
+        return;
+    }
+    perfil_t perfil = {
+        .magica = AJUSTES_MAGICA,
+        .quantidade = AJUSTES_NUM,
+    };
+    memcpy(perfil.valores, valores, sizeof(perfil.valores));
+    perfil.verificacao = fletcher16(perfil.valores, sizeof(perfil.valores));
+
+    memset(pagina, 0xFF, sizeof(pagina));
+    memcpy(pagina, &perfil, sizeof(perfil));
+    gravacao_pendente = true;
+    printf("ok gravacao agendada\n");
+}
+
+// Calibração do sensor interno por dois pontos: leituras mostradas e
+// referências, em centésimos de °C. A gravação fica para o laço principal.
+static void comando_aferir(char *const arg[4]) {
+    int32_t v[4];
+    for (int i = 0; i < 4; i++) {
+        char *fim;
+        v[i] = arg[i] ? (int32_t)strtol(arg[i], &fim, 10) : 0;
+        if (!arg[i] || *fim != '\0') {
+            printf("erro: uso aferir <lido1> <ref1> <lido2> <ref2> (centesimos de C)\n");
+            return;
+        }
+    }
+
+    int32_t ganho_q16, offset_centi;
+    if (!calibracao_calcular(calibracao_para_nominal(v[0]), v[1], calibracao_para_nominal(v[2]), v[3],
+                             &ganho_q16, &offset_centi)) {
+        printf("erro: pontos invalidos (lidos iguais ou inclinacao nao positiva)\n");
+        return;
+    }
+    if (!calibracao_salvar(ganho_q16, offset_centi)) {
+        printf("erro: setor da calibracao ocupado pela imagem do firmware\n");
+        return;
+    }
+    printf("ok calibracao agendada: ganho_q16=%ld offset=%ld centesimos\n",
+           (long)ganho_q16, (long)offset_centi);
+}
+
+static void executar_linha(char *texto) {
+    char *arg[5] = { NULL, NULL, NULL, NULL, NULL };
+    int n = 0;
+    for (char *p = strtok(texto, " \t"); p && n < 5; p = strtok(NULL, " \t")) arg[n++] = p;
+    if (n == 0) return;
+
+    if (!strcmp(arg[0], "ver")) {
+        comando_ver(arg[1]);
+    } else if (!strcmp(arg[0], "def")) {
+        comando_def(arg[1], arg[2]);
+    } else if (!strcmp(arg[0], "gravar")) {
+        comando_gravar();
+    } else if (!strcmp(arg[0], "aferir")) {
+        comando_aferir(&arg[1]);
+    } else if (!strcmp(arg[0], "padrao")) {
+        memcpy(valores, padroes, sizeof(valores));
+        pendentes = GRUPOS_TODOS;
+        aplicar_pendentes();
+        printf("ok valores de compilacao ('gravar' para manter no boot)\n");
+    } else if (!strcmp(arg[0], "ajuda")) {
+        printf("ver [nome] | def <nome> <valor> | gravar | padrao | ajuda\n"
+               "aferir <lido1> <ref1> <lido2> <ref2>: calibra o sensor interno (centesimos de C)\n"
+               "teclas: s estatisticas, r zera, b ruido, h historico, c captura\n");
+    } else {
+        printf("erro: comando desconhecido '%s' (ajuda)\n", arg[0]);
+    }
+}
+
+bool ajustes_linha_em_andamento(void) {
+    if ((n_linha || linha_longa) && time_us_32() - ultimo_caractere_us > LINHA_PRAZO_US) {
+        n_linha = 0;
+        linha_longa = false;
+    }
+    return n_linha || linha_longa;
+}
+
+void ajustes_receber(char c) {
+    ultimo_caractere_us = time_us_32();
+
+    if (c == '\n' || c == '\r') {
+        if (linha_longa) {
+            printf("erro: linha com mais de %d caracteres\n", LINHA_MAX);
+        } else if (n_linha) {
+            linha[n_linha] = '\0';
+            executar_linha(linha);
+        }
+        n_linha = 0;
+        linha_longa = false;
+        return;
+    }
+    if (c == ' ' && n_linha == 0) return;   // Espaços antes do comando
+
+    if (n_linha < LINHA_MAX) linha[n_linha++] = c;
+    else linha_longa = true;
+}
+
+void ajustes_servico(void) {
+    if (pendentes) aplicar_pendentes();
+}
+
+bool ajustes_gravacao_pendente(void) {
+    return gravacao_pendente;
+}
+
+// Executada com o outro núcleo estacionado e as interrupções desligadas.
+static void programar_perfil(void *param) {
+    (void)param;
+    flash_range_erase(AJUSTES_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(AJUSTES_FLASH_OFFSET, pagina, FLASH_PAGE_SIZE);
+}
+
+void ajustes_gravar(void) {
+    if (!gravacao_pendente) return;
+    if (flash_safe_execute(programar_perfil, NULL, MAPA_FLASH_TIMEOUT_MS) != PICO_OK) return;
+
+    gravacao_pendente = false;
+    printf("ajustes: perfil gravado\n");
+}
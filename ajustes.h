@@ -0,0 +1,110 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: ajustes.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Shell de ajustes pela USB: lê e altera em execução o
+ *      período do ciclo, os parâmetros da janela da Tarefa 1,
+ *      os limiares da tendência, o clock do I2C e os períodos
+ *      do OLED e da matriz, e grava o perfil na flash. Também
+ *      agenda a calibração do sensor interno por dois pontos.
+ *
+ *      Os comandos são linhas de texto terminadas em '\n' ou
+ *      '\r', montadas sem bloquear a partir dos caracteres
+ *      lidos por estatisticas_processar_comandos():
+ *        ver [nome]          valores, unidades e faixas
+ *        def <nome> <valor>  altera (limitado à faixa)
+ *        gravar              grava o perfil na flash
+ *        padrao              volta aos valores de compilação
+ *        aferir <lido1> <ref1> <lido2> <ref2>
+ *                            calibra o sensor interno: leituras
+ *                            mostradas e referências, em centésimos
+ *                            de °C (calibracao_salvar)
+ *        ajuda               lista os comandos
+ *      Nenhum começa por s, r, b, h ou c, que continuam sendo
+ *      comandos de uma tecla fora de uma linha.
+ *
+ *      Cada valor alterado é aplicado pelo dono, no contexto
+ *      certo: a janela por tarefa1_agendar_configuracao() (no
+ *      núcleo da aquisição), o I2C com o DMA do OLED parado, e
+ *      os períodos pela função passada a ajustes_iniciar().
+ *
+ *      Perfil na flash (um setor logo abaixo do histórico,
+ *      little-endian):
+ *        u32 magica       AJUSTES_MAGICA
+ *        u16 quantidade   valores no registro (AJUSTES_NUM)
+ *        u16 fletcher16   sobre os valores
+ *        u32 valores[quantidade]
+ *      Um perfil de outra versão (quantidade diferente) ou com
+ *      valor fora da faixa é ignorado no boot.
+ *
+ *  Relacionamento:
+ *      - Caracteres de 'estatisticas.c'; gravação pela tarefa
+ *        do histórico em 'main.c', fora da janela da Tarefa 1.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef AJUSTES_H
+#define AJUSTES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "mapa_flash.h"
+
+// Setor logo abaixo do histórico: AJUSTES_FLASH_OFFSET em mapa_flash.h
+#define AJUSTES_MAGICA       0x314A4441u   // "ADJ1"
+
+/**
+ * @brief Aplica novos períodos (múltiplos de 10 ms) à tabela de tarefas.
+ *
+ * @param ciclo_ms Ciclo de aquisição e tendência.
+ * @param oled_ms Período da Tarefa 2.
+ * @param matriz_ms Período da Tarefa 4.
+ */
+typedef void (*ajustes_periodos_t)(uint32_t ciclo_ms, uint32_t oled_ms, uint32_t matriz_ms);
+
+/**
+ * @brief Guarda os valores de compilação e carrega o perfil da flash.
+ *
+ * Os valores da aquisição e dos limiares são lidos dos módulos; os
+ * períodos vêm de quem chama. Havendo perfil válido, ele é aplicado.
+ * Chamar depois de setup() e de nucleo1_iniciar().
+ */
+void ajustes_iniciar(uint32_t ciclo_ms, uint32_t oled_ms, uint32_t matriz_ms,
+                     ajustes_periodos_t aplicar_periodos);
+
+/**
+ * @brief Indica se há uma linha começada (caracteres vão para o shell).
+ *
+ * Uma linha sem caractere novo por 2 s é descartada.
+ */
+bool ajustes_linha_em_andamento(void);
+
+/**
+ * @brief Acrescenta um caractere à linha; no fim de linha, executa.
+ */
+void ajustes_receber(char c);
+
+/**
+ * @brief Aplica os valores alterados que ainda aguardam o seu dono.
+ */
+void ajustes_servico(void);
+
+/**
+ * @brief Indica se há um perfil aguardando gravação.
+ */
+bool ajustes_gravacao_pendente(void);
+
+/**
+ * @brief Grava o perfil pendente (apaga o setor e programa uma página).
+ *
+ * Roda por flash_safe_execute(), como historico_gravar(); em caso de
+ * falha o perfil continua pendente.
+ */
+void ajustes_gravar(void);
+
+#endif  // AJUSTES_H
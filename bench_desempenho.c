@@ -0,0 +1,253 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: bench_desempenho.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Programa principal do executável TempCycleDMA_bench:
+ *      mede isoladamente cada função dos caminhos críticos do
+ *      firmware (conversão, janela da Tarefa 1, OLED, NeoPixel
+ *      e cada quadro dos efeitos) e imprime pela USB uma tabela
+ *      CSV estável, para comparar otimizações e versões.
+ *
+ *      Colunas:
+ *        funcao          nome do caso
+ *        repeticoes      execuções medidas
+ *        ciclos_min/med  ciclos do núcleo pelo SysTick (24 bits;
+ *                        acima disso, estimados pelo tempo)
+ *        us_min/med      tempo pelo timer de 1 µs
+ *        bytes_barramento média por execução no I2C do OLED e
+ *                        no fio da matriz (controle + dados)
+ *
+ *      A linha "vazio" é o custo da própria medição. Antes de
+ *      cada execução espera o fim das transferências em curso
+ *      (DMA do OLED e quadro da matriz), de modo que o tempo é
+ *      só o da CPU para as funções assíncronas.
+ *
+ *      Imprime a tabela ao conectar a USB e de novo a cada
+ *      tecla recebida. Usa setup() e as fontes do firmware, sem
+ *      o executor nem o núcleo 1.
+ *
+ *  Relacionamento:
+ *      - Alvo TempCycleDMA_bench em CMakeLists.txt, no lugar
+ *        de 'main.c'.
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+
+#include "setup.h"
+#include "tarefa1_temp.h"
+#include "tarefa2_display.h"
+#include "calibracao.h"
+#include "ssd1306.h"
+#include "display_utils.h"
+#include "draw_big_char.h"
+#include "font_big_paginada.h"
+#include "neopixel_driver.h"
+#include "efeitos.h"
+#include "testes_cores.h"
+
+#define SYSTICK_MAXIMO  0x00FFFFFFu
+#define SOMA_EXEMPLO    ((uint64_t)876 * 250000)   // Janela típica: código 876, 250 mil amostras
+
+extern uint8_t *const ssd;
+extern struct render_area area;
+
+typedef struct {
+    const char *nome;
+    void (*executar)(void);
+    efeito_quadro_t quadro;   // Alternativa a 'executar': um quadro por execução
+    uint16_t repeticoes;
+} caso_t;
+
+static uint32_t ciclos_por_us;
+static uint32_t contador = 0;           // Varia a entrada entre execuções
+static volatile int32_t sorvedouro;     // Impede que o compilador descarte resultados
+
+static void caso_vazio(void) {
+}
+
+static void caso_sensor_interno(void) {
+    sorvedouro = calibracao_bruto_para_centi(SOMA_EXEMPLO + contador++, 250000);
+}
+
+static void caso_termistor(void) {
+    sorvedouro = calibracao_termistor(0, (uint64_t)2048 * 250000 + contador++, 250000);
+}
+
+static void caso_janela_tarefa1(void) {
+    sorvedouro = (int32_t)tarefa1_obter_media_temp(&cfg_temp, DMA_TEMP_CHANNEL,
+                                                   &cfg_temp_b, DMA_TEMP_CHANNEL_B);
+}
+
+static void caso_render_on_display(void) {
+    render_on_display(ssd, &area);
+}
+
+static void caso_clear_display(void) {
+    ssd1306_clear_display(ssd);
+}
+
+static void caso_draw_big_char(void) {
+    draw_big_char(ssd, 48, 32, (contador++ & 1) ? big_digit_8_pag : big_digit_1_pag);
+}
+
+static void caso_formatar_fixo(void) {
+    char texto[FORMATO_TAMANHO_MAX];
+    sorvedouro = formatar_fixo(texto, sizeof(texto), 2000 + (int32_t)(contador++ % 1000), 2, 1,
+                               FORMATO_SINAL, "oC");
+}
+
+static void caso_mostrar_valor_grande(void) {
+    mostrar_valor_grande(ssd, NULL, 2000 + (contador++ % 100) * 10, 32);
+}
+
+// Décimo a décimo, como na Tarefa 2: em geral só o último dígito muda
+static void caso_mostrar_valor_grande_cache(void) {
+    static valor_grande_t cache;
+    mostrar_valor_grande(ssd, &cache, 2000 + (contador++ % 100) * 10, 32);
+}
+
+// Muda o valor grande e envia só o que mudou
+static void caso_flush_async(void) {
+    mostrar_valor_grande(ssd, NULL, 2000 + (contador++ % 100) * 10, 32);
+    ssd1306_flush_async(ssd);
+}
+
+static void caso_tarefa2(void) {
+    tarefa2_exibir_oled(20.0f + (contador++ % 100) / 10.0f, TENDENCIA_ESTÁVEL);
+}
+
+static void caso_npwrite_alterado(void) {
+    npSetLED(0, (uint8_t)contador++, 0, 0);
+    npWrite();
+}
+
+static void caso_npwrite_sem_mudanca(void) {
+    npWrite();
+}
+
+// Alterna o brilho: a tabela de saída é refeita a cada chamada
+static void caso_npwrite_com_brilho(void) {
+    npWriteComBrilho((contador++ & 1) ? 0.5f : 0.25f);
+}
+
+static const caso_t casos[] = {
+    { "vazio",                       caso_vazio,                NULL, 64 },
+    { "calibracao_bruto_para_centi", caso_sensor_interno,       NULL, 64 },
+    { "calibracao_termistor",        caso_termistor,            NULL, 64 },
+    { "tarefa1_obter_media_temp",    caso_janela_tarefa1,       NULL, 3 },
+    { "render_on_display",           caso_render_on_display,    NULL, 8 },
+    { "ssd1306_clear_display",       caso_clear_display,        NULL, 8 },
+    { "draw_big_char",               caso_draw_big_char,        NULL, 64 },
+    { "formatar_fixo",               caso_formatar_fixo,        NULL, 64 },
+    { "mostrar_valor_grande",        caso_mostrar_valor_grande, NULL, 32 },
+    { "mostrar_valor_grande (cache)", caso_mostrar_valor_grande_cache, NULL, 32 },
+    { "ssd1306_flush_async",         caso_flush_async,          NULL, 16 },
+    { "tarefa2_exibir_oled",         caso_tarefa2,              NULL, 16 },
+    { "npWrite (alterado)",          caso_npwrite_alterado,     NULL, 32 },
+    { "npWrite (sem mudanca)",       caso_npwrite_sem_mudanca,  NULL, 32 },
+    { "npWriteComBrilho",            caso_npwrite_com_brilho,   NULL, 32 },
+    { "quadroEspiral",               NULL, quadroEspiral,                  32 },
+    { "quadroEspiralInversa",        NULL, quadroEspiralInversa,           32 },
+    { "quadroOndaVertical",          NULL, quadroOndaVertical,             32 },
+    { "quadroOndaVerticalBrilho",    NULL, quadroOndaVerticalBrilho,       32 },
+    { "quadroFileirasColoridas",     NULL, quadroFileirasColoridas,        32 },
+    { "quadroFileirasColoridasReverso", NULL, quadroFileirasColoridasReverso, 32 },
+    { "quadroColunasColoridas",      NULL, quadroColunasColoridas,         32 },
+    { "quadroColunasColoridasReverso", NULL, quadroColunasColoridasReverso, 32 },
+    { "quadroPiscar",                NULL, quadroPiscar,                   32 },
+    { "quadro_matriz_com_cores",     NULL, quadro_matriz_com_cores,        32 },
+    { "quadro_fileiras_colunas",     NULL, quadro_fileiras_colunas,        32 },
+};
+
+static uint32_t bytes_barramento(void) {
+    return ssd1306_bytes_enviados() + npBytesEnviados();
+}
+
+static void aguardar_barramentos(void) {
+    while (ssd1306_async_busy() || npOcupado()) tight_loop_contents();
+}
+
+static void medir(const caso_t *c) {
+    static const efeito_param_t param = { COR_BRANCA, 0 };
+    uint16_t passo = 0;
+
+    uint32_t ciclos_min = UINT32_MAX, us_min = UINT32_MAX;
+    uint64_t ciclos_soma = 0, us_soma = 0;
+    uint32_t bytes_ini = bytes_barramento();
+
+    for (uint16_t i = 0; i < c->repeticoes; i++) {
+        aguardar_barramentos();
+
+        uint32_t t0 = time_us_32();
+        uint32_t c0 = systick_hw->cvr;
+        if (c->quadro) {
+            passo = c->quadro(passo, &param) ? passo + 1 : 0;   // Recomeça ao fim do efeito
+        } else {
+            c->executar();
+        }
+        uint32_t c1 = systick_hw->cvr;
+        uint32_t us = time_us_32() - t0;
+
+        // O SysTick conta para baixo e dá a volta a cada 2^24 ciclos
+        uint32_t ciclos = (us < SYSTICK_MAXIMO / ciclos_por_us) ? ((c0 - c1) & SYSTICK_MAXIMO)
+                                                                 : us * ciclos_por_us;
+        if (ciclos < ciclos_min) ciclos_min = ciclos;
+        if (us < us_min) us_min = us;
+        ciclos_soma += ciclos;
+        us_soma += us;
+    }
+    aguardar_barramentos();
+
+    printf("%s,%u,%lu,%lu,%lu,%lu,%lu\n", c->nome, c->repeticoes,
+           (unsigned long)ciclos_min, (unsigned long)(ciclos_soma / c->repeticoes),
+           (unsigned long)us_min, (unsigned long)(us_soma / c->repeticoes),
+           (unsigned long)((bytes_barramento() - bytes_ini) / c->repeticoes));
+}
+
+static void executar_tabela(void) {
+    printf("# TempCycleDMA_bench %s %s clk_sys=%lu Hz\n", __DATE__, __TIME__,
+           (unsigned long)clock_get_hz(clk_sys));
+    printf("funcao,repeticoes,ciclos_min,ciclos_med,us_min,us_med,bytes_barramento\n");
+
+    uint8_t brilho = npGetBrilho();
+    for (uint32_t k = 0; k < sizeof(casos) / sizeof(casos[0]); k++) {
+        medir(&casos[k]);
+    }
+    npSetBrilho(brilho);
+    npClear();
+    npWrite();
+    printf("# fim\n");
+}
+
+int main() {
+    setup();
+    setup_saidas();
+
+    // SysTick livre a partir do clock do processador, recarga máxima
+    systick_hw->rvr = SYSTICK_MAXIMO;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;   // ENABLE | CLKSOURCE (processador), sem interrupção
+    ciclos_por_us = clock_get_hz(clk_sys) / 1000000;
+
+    while (true) {
+        while (!stdio_usb_connected()) sleep_ms(100);
+        sleep_ms(500);   // O terminal costuma perder o início logo após conectar
+
+        executar_tabela();
+
+        // Nova rodada a cada tecla
+        while (getchar_timeout_us(1000000) == PICO_ERROR_TIMEOUT) {
+            if (!stdio_usb_connected()) break;
+        }
+    }
+}
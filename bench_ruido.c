@@ -0,0 +1,115 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: bench_ruido.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Implementação do benchmark de ruído. O desvio entre
+ *      janelas é o ruído da temperatura entregue a cada ciclo;
+ *      o desvio do fluxo decimado mostra o ruído de cada saída
+ *      do boxcar (200 saídas/s em todas as taxas).
+ *
+ *      A conversão para m°C usa a curva nominal do sensor
+ *      (0,806 mV por código, 1,721 mV/°C), sem a calibração.
+ *      Os resultados saem em ponto fixo (formato.h), já que o
+ *      printf do firmware não tem %f.
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/watchdog.h"
+#include "setup.h"
+#include "tarefa1_temp.h"
+#include "bench_ruido.h"
+#include "formato.h"
+
+#define MILI_C_POR_LSB (3300.0 / 4096.0 / 1.721 * 1000.0)
+#define SAIDAS_DECIMADAS_POR_S 200
+
+static const uint32_t taxas_sps[] = { 500000, 200000, 100000, 50000, 20000, 10000, 5000 };
+
+// Desvio padrão amostral a partir de soma e soma dos quadrados
+static double desvio(double soma, double soma_q, uint32_t n) {
+    if (n < 2) return 0.0;
+    double var = (soma_q - soma * soma / n) / (n - 1);
+    return var > 0.0 ? sqrt(var) : 0.0;
+}
+
+// 'v' com 'casas' decimais, em 'texto' (FORMATO_TAMANHO_MAX bytes)
+static const char *fixo(char *texto, double v, uint8_t casas) {
+    static const double escalas[] = { 1.0, 10.0, 100.0, 1000.0, 10000.0 };
+    formatar_fixo(texto, FORMATO_TAMANHO_MAX, (int32_t)lround(v * escalas[casas]), casas, casas, 0, NULL);
+    return texto;
+}
+
+void bench_ruido_executar(uint8_t janelas) {
+#if TEMPCYCLE_MULTICORE
+    (void)janelas;
+    printf("bench: indisponivel com TEMPCYCLE_MULTICORE (Tarefa 1 no nucleo 1)\n");
+#else
+    // 'b' chega pela tarefa de comandos, em geral com a janela do ciclo em
+    // curso; tarefa1_configurar() recusaria os parâmetros até ela terminar
+    while (tarefa1_em_andamento()) {
+        if (!tarefa1_pronta()) tarefa1_aguardar();
+    }
+    watchdog_update();
+
+    const tarefa1_parametros_t original = *tarefa1_parametros();
+
+    printf("taxa_sps,amostras,media_lsb,desvio_janelas_lsb,desvio_janelas_mC,desvio_decimado_lsb\n");
+    for (uint32_t k = 0; k < sizeof(taxas_sps) / sizeof(taxas_sps[0]); k++) {
+        tarefa1_parametros_t p = original;
+        p.taxa_sps = taxas_sps[k];
+        p.decimacao = (uint16_t)(taxas_sps[k] / SAIDAS_DECIMADAS_POR_S);
+        if (p.decimacao == 0) p.decimacao = 1;
+        if (!tarefa1_configurar(&p)) {
+            printf("bench: erro ao configurar %lu amostras/s\n", (unsigned long)taxas_sps[k]);
+            continue;
+        }
+        uint32_t taxa = tarefa1_parametros()->taxa_sps;   // Já limitada à faixa do ADC
+
+        double soma = 0.0, soma_q = 0.0;
+        double soma_dec = 0.0, soma_q_dec = 0.0;
+        uint32_t n_dec = 0, amostras = 0, validas = 0;
+
+        for (uint8_t j = 0; j < janelas; j++) {
+            tarefa1_obter_media_temp(&cfg_temp, DMA_TEMP_CHANNEL, &cfg_temp_b, DMA_TEMP_CHANNEL_B);
+            watchdog_update();   // Cada janela bloqueia o laço por ~0,5 s
+            const tarefa1_resultado_t *r = tarefa1_resultado();
+            if (r->amostras == 0) continue;
+
+            double media = (double)r->soma_bruta / r->amostras;
+            soma += media;
+            soma_q += media * media;
+            amostras = r->amostras;
+            validas++;
+
+            const uint16_t *dec;
+            uint32_t n = tarefa1_decimadas(&dec);
+            for (uint32_t i = 0; i < n; i++) {
+                double v = dec[i] / 16.0;
+                soma_dec += v;
+                soma_q_dec += v * v;
+            }
+            n_dec += n;
+        }
+
+        double desvio_janelas = desvio(soma, soma_q, validas);
+        char media[FORMATO_TAMANHO_MAX], dj[FORMATO_TAMANHO_MAX], dj_mc[FORMATO_TAMANHO_MAX],
+             dd[FORMATO_TAMANHO_MAX];
+        printf("%lu,%lu,%s,%s,%s,%s\n",
+               (unsigned long)taxa, (unsigned long)amostras,
+               fixo(media, validas ? soma / validas : 0.0, 3),
+               fixo(dj, desvio_janelas, 4), fixo(dj_mc, desvio_janelas * MILI_C_POR_LSB, 1),
+               fixo(dd, desvio(soma_dec, soma_q_dec, n_dec), 3));
+    }
+
+    // Sem janela em curso a restauração não falha; se falhar, vale na próxima
+    if (!tarefa1_configurar(&original)) tarefa1_agendar_configuracao(&original);
+#endif
+}
@@ -0,0 +1,33 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: bench_ruido.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Benchmark de ruído da Tarefa 1 em função do número de
+ *      amostras: para cada taxa do ADC executa algumas janelas
+ *      e imprime (CSV pela USB) a média, o desvio padrão entre
+ *      as médias das janelas e o desvio do fluxo decimado
+ *      dentro da janela.
+ *
+ *      É bloqueante (vários segundos); disparado pelo comando
+ *      'b' na USB. Restaura os parâmetros da Tarefa 1 ao final.
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef BENCH_RUIDO_H
+#define BENCH_RUIDO_H
+
+#include <stdint.h>
+
+/**
+ * @brief Executa o benchmark de ruído.
+ *
+ * @param janelas Janelas de aquisição por taxa.
+ */
+void bench_ruido_executar(uint8_t janelas);
+
+#endif  // BENCH_RUIDO_H
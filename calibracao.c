@@ -0,0 +1,186 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: calibracao.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Conversão em ponto fixo da média bruta do ADC para
+ *      temperatura, com a curva nominal do sensor interno
+ *      do RP2040:
+ *
+ *          V = bruto × 3,3 / 4096
+ *          T = 27 - (V - 0,706) / 0,001721
+ *
+ *      A tensão é calculada em µV a partir da soma das
+ *      amostras (64 bits), e a temperatura em centésimos de
+ *      grau. Sobre o valor nominal aplica-se a calibração do
+ *      dispositivo: T_cal = T × ganho + offset.
+ *
+ *      O registro de calibração fica no último setor da flash
+ *      e é lido diretamente pelo XIP. Um registro novo (comando
+ *      'cal' do shell de ajustes) só passa a valer quando o laço
+ *      principal o grava, fora das janelas da Tarefa 1.
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <math.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "calibracao.h"
+
+#define VREF_UV        3300000   // Referência do ADC em µV
+#define ADC_ESCALA     4096      // 12 bits
+#define V27_UV         706000    // Tensão do sensor a 27 °C em µV
+#define INCLINACAO_UV  1721      // µV por °C
+
+static calibracao_t calibracao = {
+    .magica = CALIBRACAO_MAGICA,
+    .ganho_q16 = CALIBRACAO_GANHO_UNITARIO,
+    .offset_centi = 0,
+};
+
+static uint32_t calcular_verificacao(const calibracao_t *cal) {
+    return ~(cal->magica + (uint32_t)cal->ganho_q16 + (uint32_t)cal->offset_centi);
+}
+
+// Divisão inteira com arredondamento para o mais próximo
+static int64_t dividir_arredondado(int64_t num, int64_t den) {
+    return (num >= 0) ? (num + den / 2) / den : (num - den / 2) / den;
+}
+
+void calibracao_carregar(void) {
+    const calibracao_t *gravada = (const calibracao_t *)(XIP_BASE + CALIBRACAO_FLASH_OFFSET);
+
+    if (gravada->magica == CALIBRACAO_MAGICA &&
+        gravada->verificacao == calcular_verificacao(gravada)) {
+        calibracao = *gravada;
+    } else {
+        calibracao.ganho_q16 = CALIBRACAO_GANHO_UNITARIO;
+        calibracao.offset_centi = 0;
+    }
+    calibracao.magica = CALIBRACAO_MAGICA;
+    calibracao.verificacao = calcular_verificacao(&calibracao);
+}
+
+const calibracao_t *calibracao_atual(void) {
+    return &calibracao;
+}
+
+static bool gravacao_pendente = false;
+static calibracao_t nova;              // Registro agendado por calibracao_salvar()
+static uint8_t pagina[FLASH_PAGE_SIZE];
+
+// Executada com o outro núcleo estacionado e as interrupções desligadas.
+static void programar_calibracao(void *param) {
+    (void)param;
+    flash_range_erase(CALIBRACAO_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(CALIBRACAO_FLASH_OFFSET, pagina, FLASH_PAGE_SIZE);
+}
+
+bool calibracao_salvar(int32_t ganho_q16, int32_t offset_centi) {
+    // A imagem do firmware não pode alcançar o setor da calibração
+    if (!mapa_flash_livre(CALIBRACAO_FLASH_OFFSET)) return false;
+
+    nova.magica = CALIBRACAO_MAGICA;
+    nova.ganho_q16 = ganho_q16;
+    nova.offset_centi = offset_centi;
+    nova.verificacao = calcular_verificacao(&nova);
+
+    memset(pagina, 0xFF, sizeof(pagina));
+    memcpy(pagina, &nova, sizeof(nova));
+    gravacao_pendente = true;
+    return true;
+}
+
+bool calibracao_gravacao_pendente(void) {
+    return gravacao_pendente;
+}
+
+void calibracao_gravar(void) {
+    if (!gravacao_pendente) return;
+    if (flash_safe_execute(programar_calibracao, NULL, MAPA_FLASH_TIMEOUT_MS) != PICO_OK) return;
+
+    calibracao = nova;
+    gravacao_pendente = false;
+}
+
+int32_t calibracao_para_nominal(int32_t centi) {
+    return (int32_t)dividir_arredondado((int64_t)(centi - calibracao.offset_centi) * CALIBRACAO_GANHO_UNITARIO,
+                                        calibracao.ganho_q16);
+}
+
+bool calibracao_calcular(int32_t medido1, int32_t ref1, int32_t medido2, int32_t ref2,
+                         int32_t *ganho_q16, int32_t *offset_centi) {
+    if (medido1 == medido2) return false;
+
+    int64_t ganho = dividir_arredondado((int64_t)(ref2 - ref1) * CALIBRACAO_GANHO_UNITARIO,
+                                        medido2 - medido1);
+    if (ganho <= 0 || ganho > INT32_MAX) return false;
+    *ganho_q16 = (int32_t)ganho;
+    *offset_centi = ref1 - (int32_t)dividir_arredondado((int64_t)medido1 * ganho,
+                                                         CALIBRACAO_GANHO_UNITARIO);
+    return true;
+}
+
+int32_t calibracao_bruto_para_centi(uint64_t soma_bruta, uint32_t amostras) {
+    if (amostras == 0) return CALIBRACAO_INVALIDA;
+
+    // Tensão média em µV: soma × Vref / (4096 × n)
+    int64_t tensao_uv = (int64_t)((soma_bruta * VREF_UV + (uint64_t)ADC_ESCALA * amostras / 2) /
+                                  ((uint64_t)ADC_ESCALA * amostras));
+
+    // Curva nominal em centésimos de grau
+    int64_t nominal = 2700 - dividir_arredondado((tensao_uv - V27_UV) * 100, INCLINACAO_UV);
+
+    return (int32_t)(dividir_arredondado(nominal * calibracao.ganho_q16, CALIBRACAO_GANHO_UNITARIO) +
+                     calibracao.offset_centi);
+}
+
+// --- Conversão por canal ---
+
+static calibracao_termistor_t termistores[CALIBRACAO_CANAIS - 1] = {
+    { 10000, 10000, 3950 }, { 10000, 10000, 3950 },
+    { 10000, 10000, 3950 }, { 10000, 10000, 3950 },
+};
+
+static calibracao_conversao_t conversoes[CALIBRACAO_CANAIS] = {
+    calibracao_termistor, calibracao_termistor,
+    calibracao_termistor, calibracao_termistor,
+    calibracao_sensor_interno,
+};
+
+int32_t calibracao_sensor_interno(uint8_t canal, uint64_t soma_bruta, uint32_t amostras) {
+    (void)canal;
+    return calibracao_bruto_para_centi(soma_bruta, amostras);
+}
+
+int32_t calibracao_termistor(uint8_t canal, uint64_t soma_bruta, uint32_t amostras) {
+    if (amostras == 0 || canal >= CALIBRACAO_CANAIS - 1) return CALIBRACAO_INVALIDA;
+    const calibracao_termistor_t *t = &termistores[canal];
+
+    // Uma única conta em ponto flutuante por janela: R = Rs × c / (4096 − c)
+    float codigo = (float)soma_bruta / amostras;
+    if (codigo <= 0.5f || codigo >= ADC_ESCALA - 0.5f) return CALIBRACAO_INVALIDA;   // Aberto ou em curto
+    float r = t->r_serie_ohm * codigo / (ADC_ESCALA - codigo);
+
+    float kelvin = 1.0f / (1.0f / 298.15f + logf(r / t->r0_ohm) / t->beta);
+    return (int32_t)lroundf((kelvin - 273.15f) * 100.0f);
+}
+
+void calibracao_definir_conversao(uint8_t canal, calibracao_conversao_t conversao) {
+    if (canal < CALIBRACAO_CANAIS) conversoes[canal] = conversao;
+}
+
+void calibracao_definir_termistor(uint8_t canal, const calibracao_termistor_t *t) {
+    if (canal < CALIBRACAO_CANAIS - 1) termistores[canal] = *t;
+}
+
+int32_t calibracao_canal_para_centi(uint8_t canal, uint64_t soma_bruta, uint32_t amostras) {
+    if (canal >= CALIBRACAO_CANAIS || conversoes[canal] == NULL) return CALIBRACAO_INVALIDA;
+    return conversoes[canal](canal, soma_bruta, amostras);
+}
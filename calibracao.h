@@ -0,0 +1,160 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: calibracao.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Interface da conversão bruto → Celsius em ponto fixo e
+ *      do registro de calibração por dispositivo gravado no
+ *      último setor da flash.
+ *
+ *      Temperaturas são tratadas em centésimos de grau
+ *      (int32_t, 2534 = 25,34 °C).
+ *
+ *      Cada entrada do ADC tem a sua função de conversão
+ *      (calibracao_definir_conversao): por padrão o canal 4 usa
+ *      o sensor interno com o registro da flash, e os canais
+ *      0 a 3 um termistor NTC pela equação Beta. Um canal sem
+ *      leitura (nenhuma amostra na janela, termistor aberto ou
+ *      em curto) devolve CALIBRACAO_INVALIDA, que a tendência,
+ *      a telemetria e o display ignoram.
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef CALIBRACAO_H
+#define CALIBRACAO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hardware/flash.h"
+#include "mapa_flash.h"
+
+// Registro no último setor da flash (CALIBRACAO_FLASH_OFFSET em mapa_flash.h)
+#define CALIBRACAO_MAGICA       0x43414C31u   // "CAL1"
+#define CALIBRACAO_GANHO_UNITARIO 65536       // 1,0 em Q16.16
+#define CALIBRACAO_CANAIS       5             // Entradas do ADC (0-3 GPIO, 4 sensor interno)
+#define CALIBRACAO_INVALIDA     INT32_MIN     // Canal sem temperatura (termistor aberto ou em curto)
+
+typedef struct {
+    uint32_t magica;        // CALIBRACAO_MAGICA quando o registro é válido
+    int32_t  ganho_q16;     // Inclinação sobre a curva nominal (Q16.16)
+    int32_t  offset_centi;  // Deslocamento após o ganho (centésimos de °C)
+    uint32_t verificacao;   // Complemento da soma dos campos anteriores
+} calibracao_t;
+
+/**
+ * @brief Lê o registro da flash; se ausente ou corrompido, usa ganho 1 e offset 0.
+ */
+void calibracao_carregar(void);
+
+/**
+ * @brief Retorna a calibração em uso.
+ */
+const calibracao_t *calibracao_atual(void);
+
+/**
+ * @brief Agenda um novo registro para calibracao_gravar().
+ *
+ * Até a gravação, as conversões continuam com a calibração atual.
+ *
+ * @param ganho_q16 Inclinação em Q16.16.
+ * @param offset_centi Deslocamento em centésimos de °C.
+ * @return false se o setor da calibração estiver ocupado pela imagem
+ *         do firmware; nada é agendado.
+ */
+bool calibracao_salvar(int32_t ganho_q16, int32_t offset_centi);
+
+/**
+ * @brief Indica se há um registro agendado por calibracao_salvar().
+ */
+bool calibracao_gravacao_pendente(void);
+
+/**
+ * @brief Grava o registro agendado e passa a usá-lo.
+ *
+ * Apaga o setor via flash_safe_execute(), como historico_gravar(); deve
+ * rodar fora das janelas da Tarefa 1, o que também impede uma conversão
+ * no meio da troca. Em caso de falha o registro continua pendente.
+ */
+void calibracao_gravar(void);
+
+/**
+ * @brief Desfaz a calibração atual de uma leitura (centésimos de °C).
+ *
+ * Leva as leituras mostradas ao valor nominal esperado por
+ * calibracao_calcular().
+ */
+int32_t calibracao_para_nominal(int32_t centi);
+
+/**
+ * @brief Calcula ganho e offset a partir de dois pontos de referência.
+ *
+ * @param medido1 Leitura nominal no ponto 1 (centésimos de °C).
+ * @param ref1 Temperatura de referência no ponto 1.
+ * @param medido2 Leitura nominal no ponto 2.
+ * @param ref2 Temperatura de referência no ponto 2.
+ * @param ganho_q16 Saída: inclinação em Q16.16.
+ * @param offset_centi Saída: deslocamento em centésimos de °C.
+ * @return false se os dois pontos medidos forem iguais ou a inclinação
+ *         resultante não for positiva.
+ */
+bool calibracao_calcular(int32_t medido1, int32_t ref1, int32_t medido2, int32_t ref2,
+                         int32_t *ganho_q16, int32_t *offset_centi);
+
+/**
+ * @brief Converte a soma de códigos brutos de 12 bits em temperatura calibrada.
+ *
+ * Toda a conta é feita em inteiros: uma única conversão por janela,
+ * independentemente do número de amostras.
+ *
+ * @param soma_bruta Soma dos códigos brutos do ADC.
+ * @param amostras Número de amostras somadas.
+ * @return Temperatura em centésimos de °C, ou CALIBRACAO_INVALIDA sem amostras.
+ */
+int32_t calibracao_bruto_para_centi(uint64_t soma_bruta, uint32_t amostras);
+
+// Conversão da soma bruta de um canal em centésimos de °C
+typedef int32_t (*calibracao_conversao_t)(uint8_t canal, uint64_t soma_bruta, uint32_t amostras);
+
+// Termistor NTC em divisor: 3V3 — r_serie — ADC — NTC — GND
+typedef struct {
+    uint32_t r_serie_ohm;   // Resistor fixo do divisor
+    uint32_t r0_ohm;        // Resistência do NTC a 25 °C
+    uint16_t beta;          // Constante Beta (K)
+} calibracao_termistor_t;
+
+/**
+ * @brief Substitui a conversão de um canal do ADC.
+ */
+void calibracao_definir_conversao(uint8_t canal, calibracao_conversao_t conversao);
+
+/**
+ * @brief Altera os parâmetros do termistor ligado a um canal (0 a 3).
+ */
+void calibracao_definir_termistor(uint8_t canal, const calibracao_termistor_t *t);
+
+/**
+ * @brief Converte a soma bruta de um canal com a conversão dele.
+ *
+ * @return Temperatura em centésimos de °C, ou CALIBRACAO_INVALIDA sem amostras
+ *         ou sem conversão para o canal.
+ */
+int32_t calibracao_canal_para_centi(uint8_t canal, uint64_t soma_bruta, uint32_t amostras);
+
+/**
+ * @brief Conversão padrão do canal 4 (sensor interno, com o registro da flash).
+ */
+int32_t calibracao_sensor_interno(uint8_t canal, uint64_t soma_bruta, uint32_t amostras);
+
+/**
+ * @brief Conversão padrão dos canais 0 a 3 (termistor NTC, equação Beta).
+ *
+ * @return Centésimos de °C, ou CALIBRACAO_INVALIDA sem amostras ou com o
+ *         código médio no extremo da escala (termistor aberto ou em curto).
+ */
+int32_t calibracao_termistor(uint8_t canal, uint64_t soma_bruta, uint32_t amostras);
+
+#endif  // CALIBRACAO_H
@@ -0,0 +1,219 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: captura.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Empacotamento dos blocos do ping-pong e envio pela CDC
+ *      (formato em captura.h).
+ *
+ *      A aquisição (núcleo 1 no modo de dois núcleos) publica
+ *      o descritor do último bloco com um contador de versão:
+ *      ímpar durante a escrita, e quem envia copia o descritor
+ *      e confere que a versão não mudou. O envio (núcleo 0)
+ *      guarda o próprio progresso e conta as perdas: o bloco
+ *      trocado antes do último trecho, o alcançado pelo DMA e
+ *      os números de bloco que nem chegou a ver.
+ *
+ *      Um trecho só é escrito com espaço para ele inteiro no
+ *      FIFO de TX, e em uma escrita só de 'usb_binario.c', de
+ *      modo que um bloco interrompido nunca deixa um trecho
+ *      pela metade no fluxo.
+ *
+ *  Relacionamento:
+ *      - dma_temp_blocos_concluidos de 'irq_handlers.c' diz até
+ *        quando a metade do bloco é válida.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "captura.h"
+#include "historico.h"
+#include "irq_handlers.h"
+#include "usb_binario.h"
+#include "fletcher16.h"
+
+typedef struct {
+    const uint8_t *dados;      // Bloco empacotado, na metade do ping-pong
+    uint32_t bloco;
+    uint32_t amostras;
+    uint8_t canais;
+    uint8_t fase;
+    uint32_t fim_us;
+    uint32_t valido_ate;
+    uint16_t somas[CAPTURA_TRECHOS_MAX];   // fletcher16 das amostras de cada trecho
+} bloco_capturado_t;
+
+static volatile bool ativa = false;
+
+// Escritos pela aquisição
+static bloco_capturado_t publicado;
+static volatile uint32_t versao = 0;       // Ímpar durante a escrita; 0 = nenhum bloco
+static uint32_t proximo_bloco = 0;
+
+// Estado do envio
+static bool recebido = false;              // 'bloco_atual' é válido
+static uint32_t bloco_atual;
+static uint32_t trecho = 0, trechos_bloco = 0;
+static uint32_t enviados = 0, perdidos = 0;
+
+static uint32_t num_trechos(uint32_t amostras) {
+    return (amostras + CAPTURA_AMOSTRAS_TRECHO - 1) / CAPTURA_AMOSTRAS_TRECHO;
+}
+
+static bool ler_publicado(bloco_capturado_t *b) {
+    uint32_t v = versao;
+    if (v == 0 || (v & 1)) return false;
+    __dmb();            // Versão lida antes do conteúdo
+    *b = publicado;
+    __dmb();
+    return versao == v;
+}
+
+// A metade foi reescrita pelo DMA (ou por uma janela nova)
+static bool bloco_expirado(const bloco_capturado_t *b) {
+    return (int32_t)(dma_temp_blocos_concluidos - b->valido_ate) > 0;
+}
+
+void captura_alternar(void) {
+#if TAREFA1_USAR_SNIFFER
+    printf("captura: indisponivel no modo sniffer\n");
+#else
+    if (ativa) {
+        ativa = false;
+        printf("captura: desligada enviados=%lu perdidos=%lu\n",
+               (unsigned long)enviados, (unsigned long)perdidos);
+        return;
+    }
+
+    // O bloco ainda publicado é de uma captura anterior: conta como enviado
+    bloco_capturado_t b;
+    recebido = ler_publicado(&b);
+    bloco_atual = recebido ? b.bloco : 0;
+    trecho = trechos_bloco = 0;
+    enviados = perdidos = 0;
+    printf("captura: ligada\n");
+    __dmb();
+    ativa = true;
+#endif
+}
+
+bool captura_ativa(void) {
+    return ativa;
+}
+
+void captura_entregar(uint16_t *amostras, uint32_t n, uint8_t canais, uint8_t fase,
+                      uint32_t fim_us, uint32_t valido_ate) {
+    if (n > CAPTURA_BLOCO_MAX) n = CAPTURA_BLOCO_MAX;
+
+    // Pares em 3 bytes, no lugar: a escrita (1,5 byte por amostra) nunca
+    // passa da leitura (2 bytes por amostra), e o par é lido antes
+    uint8_t *saida = (uint8_t *)amostras;
+    uint16_t somas[CAPTURA_TRECHOS_MAX];
+    uint32_t trechos = num_trechos(n);
+    for (uint32_t k = 0; k < trechos; k++) {
+        uint32_t i = k * CAPTURA_AMOSTRAS_TRECHO;
+        uint32_t fim = i + CAPTURA_AMOSTRAS_TRECHO < n ? i + CAPTURA_AMOSTRAS_TRECHO : n;
+        uint8_t *inicio = saida + i / 2 * 3, *w = inicio;
+        for (; i + 1 < fim; i += 2) {
+            uint16_t a = amostras[i], b = amostras[i + 1];
+            w[0] = (uint8_t)a;
+            w[1] = (uint8_t)((a >> 8) | (b << 4));
+            w[2] = (uint8_t)(b >> 4);
+            w += 3;
+        }
+        if (i < fim) {              // Amostra ímpar no fim do bloco
+            uint16_t a = amostras[i];
+            w[0] = (uint8_t)a;
+            w[1] = (uint8_t)(a >> 8);
+            w += 2;
+        }
+        somas[k] = fletcher16(inicio, (uint32_t)(w - inicio));
+    }
+
+    versao = versao + 1;    // Ímpar: em escrita
+    __dmb();
+    publicado.dados = saida;
+    publicado.bloco = proximo_bloco++;
+    publicado.amostras = n;
+    publicado.canais = canais;
+    publicado.fase = fase;
+    publicado.fim_us = fim_us;
+    publicado.valido_ate = valido_ate;
+    for (uint32_t k = 0; k < trechos; k++) publicado.somas[k] = somas[k];
+    __dmb();
+    versao = versao + 1;
+}
+
+void captura_invalidar(void) {
+    if (versao == 0) return;
+    versao = versao + 1;
+    __dmb();
+    publicado.valido_ate = dma_temp_blocos_concluidos - 1;
+    __dmb();
+    versao = versao + 1;
+}
+
+void captura_servico(void) {
+    // O histórico em envio usa a USB sozinho; os blocos do intervalo se perdem
+    if (!ativa || historico_exportando() || !usb_binario_conectado()) return;
+
+    bloco_capturado_t b;
+    while (ler_publicado(&b)) {
+        if (!recebido || b.bloco != bloco_atual) {
+            if (recebido) {
+                if (trecho < trechos_bloco) perdidos++;    // Trocado no meio
+                perdidos += b.bloco - bloco_atual - 1;     // Nem chegaram aqui
+            }
+            recebido = true;
+            bloco_atual = b.bloco;
+            trecho = 0;
+            trechos_bloco = num_trechos(b.amostras);
+        }
+        if (trecho >= trechos_bloco) break;
+        if (bloco_expirado(&b)) {
+            perdidos++;
+            trecho = trechos_bloco;
+            break;
+        }
+
+        uint32_t ini = trecho * CAPTURA_AMOSTRAS_TRECHO;
+        uint32_t n = b.amostras - ini < CAPTURA_AMOSTRAS_TRECHO ? b.amostras - ini : CAPTURA_AMOSTRAS_TRECHO;
+        uint32_t bytes = (3 * n + 1) / 2;
+        uint32_t total = sizeof(captura_cabecalho_t) + bytes + sizeof(uint16_t);
+        if (usb_binario_livre() < total) break;
+
+        captura_cabecalho_t c = {
+            .sincronismo = CAPTURA_SINCRONISMO,
+            .versao = CAPTURA_VERSAO,
+            .amostras = (uint8_t)n,
+            .bloco = b.bloco,
+            .deslocamento = (uint16_t)ini,
+            .canais = b.canais,
+            .fase = (uint8_t)((b.fase + ini) % (uint32_t)__builtin_popcount(b.canais)),
+            .fim_us = b.fim_us,
+            .perdidos = perdidos,
+        };
+        uint16_t soma = fletcher16_juntar(fletcher16(&c, sizeof(c)), b.somas[trecho], bytes);
+
+        // Trecho montado inteiro para sair em uma escrita, sob o mutex do stdio_usb
+        uint8_t quadro[sizeof(captura_cabecalho_t) + CAPTURA_AMOSTRAS_TRECHO * 3 / 2 + sizeof(uint16_t)];
+        memcpy(quadro, &c, sizeof(c));
+        memcpy(quadro + sizeof(c), b.dados + ini / 2 * 3, bytes);
+        memcpy(quadro + sizeof(c) + bytes, &soma, sizeof(soma));
+        usb_binario_escrever(quadro, total);
+
+        if (++trecho == trechos_bloco) enviados++;
+    }
+}
+
+void captura_imprimir_estado(void) {
+    printf("captura: ativa=%s enviados=%lu perdidos=%lu\n", ativa ? "sim" : "nao",
+           (unsigned long)enviados, (unsigned long)perdidos);
+}
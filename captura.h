@@ -0,0 +1,124 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: captura.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Captura das amostras brutas do ADC pela USB, para
+ *      análise de ruído e da média fora da placa. Ligada e
+ *      desligada pela tecla 'c'; só existe no modo ping-pong
+ *      (o sniffer não guarda amostras).
+ *
+ *      Cada bloco do ping-pong, depois de somado pela Tarefa 1,
+ *      é empacotado em 12 bits na própria metade do buffer
+ *      (duas amostras em 3 bytes, escritos sempre antes do que
+ *      ainda resta ler) e entregue a captura_servico(), que o
+ *      envia à CDC a partir dessa metade, sem texto.
+ *      A 500 ksps são 750 KB/s durante a janela, perto do que
+ *      a USB full-speed entrega: os blocos que não couberem são
+ *      perdidos inteiros e contados, e uma taxa menor ('def
+ *      taxa') dá um fluxo contínuo.
+ *
+ *      A metade só vale até o DMA voltar a ela, no fim do bloco
+ *      seguinte; a partir daí o restante do bloco é descartado.
+ *      O bloco sai em trechos de até CAPTURA_AMOSTRAS_TRECHO
+ *      amostras, cada um escrito de uma vez na CDC:
+ *        u16 sincronismo  CAPTURA_SINCRONISMO
+ *        u8  versao       CAPTURA_VERSAO
+ *        u8  amostras     no trecho
+ *        u32 bloco        número do bloco (lacunas = perdidos)
+ *        u16 deslocamento primeira amostra do trecho no bloco
+ *        u8  canais       máscara do round-robin
+ *        u8  fase         posição da primeira amostra na sequência
+ *        u32 fim_us       fim do bloco no IRQ do DMA (time_us_32)
+ *        u32 perdidos     blocos não enviados inteiros, no total
+ *        amostras × 12 bits: pares em 3 bytes (a[7:0],
+ *          a[11:8] | b[3:0] << 4, b[11:4]); uma amostra ímpar
+ *          no fim ocupa 2 bytes
+ *        u16 fletcher16   sobre o cabeçalho e as amostras
+ *      A soma das amostras é feita no empacotamento: um trecho
+ *      que o DMA alcançou durante o envio não confere e é
+ *      descartado pelo host (tools/gravar_captura.py).
+ *
+ *      Durante a captura a telemetria fica suspensa, como no
+ *      envio do histórico.
+ *
+ *  Relacionamento:
+ *      - Blocos entregues por 'tarefa1_temp.c', no núcleo da
+ *        aquisição; envio no laço principal de 'main.c'.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef CAPTURA_H
+#define CAPTURA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define CAPTURA_SINCRONISMO     0x5CC5
+#define CAPTURA_VERSAO          1
+#define CAPTURA_AMOSTRAS_TRECHO 128    // 20 + 192 + 2 bytes: cabe no FIFO de TX da CDC
+#define CAPTURA_BLOCO_MAX       5000   // Maior bloco do ping-pong
+#define CAPTURA_TRECHOS_MAX     ((CAPTURA_BLOCO_MAX + CAPTURA_AMOSTRAS_TRECHO - 1) / CAPTURA_AMOSTRAS_TRECHO)
+
+typedef struct __attribute__((packed)) {
+    uint16_t sincronismo;
+    uint8_t versao;
+    uint8_t amostras;
+    uint32_t bloco;
+    uint16_t deslocamento;
+    uint8_t canais;
+    uint8_t fase;
+    uint32_t fim_us;
+    uint32_t perdidos;
+} captura_cabecalho_t;
+
+_Static_assert(sizeof(captura_cabecalho_t) == 20, "cabeçalho da captura deve ter 20 bytes");
+
+/**
+ * @brief Liga ou desliga a captura (tecla 'c').
+ */
+void captura_alternar(void);
+
+/**
+ * @brief Indica se a captura está ligada.
+ */
+bool captura_ativa(void);
+
+/**
+ * @brief Empacota um bloco já somado e o entrega para envio.
+ *
+ * Chamada pela Tarefa 1, no núcleo da aquisição. O bloco anterior,
+ * na outra metade, deixa de ser enviado.
+ *
+ * @param amostras  Metade do ping-pong; é sobrescrita pelo empacotamento.
+ * @param n         Amostras no bloco (até CAPTURA_BLOCO_MAX).
+ * @param canais    Máscara do round-robin.
+ * @param fase      Posição da primeira amostra na sequência de canais.
+ * @param fim_us    Instante do fim do bloco no IRQ.
+ * @param valido_ate Valor de dma_temp_blocos_concluidos até o qual a
+ *                  metade não é reescrita pelo DMA.
+ */
+void captura_entregar(uint16_t *amostras, uint32_t n, uint8_t canais, uint8_t fase,
+                      uint32_t fim_us, uint32_t valido_ate);
+
+/**
+ * @brief Marca o último bloco como inválido (nova janela sobre o buffer).
+ */
+void captura_invalidar(void);
+
+/**
+ * @brief Envia à USB os trechos que couberem no espaço livre de
+ *        transmissão. Chamada a cada volta do laço principal.
+ */
+void captura_servico(void);
+
+/**
+ * @brief Imprime blocos enviados e perdidos.
+ */
+void captura_imprimir_estado(void);
+
+#endif  // CAPTURA_H
@@ -0,0 +1,131 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: dma_servico.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Implementação do serviço de canais DMA (dma_servico.h).
+ *
+ *      Cada linha guarda a máscara dos canais com callback;
+ *      o handler percorre só esses bits, reconhece o status
+ *      do canal e chama a função registrada. O status é limpo
+ *      antes do callback, de modo que um canal re-disparado
+ *      dentro dele volta a interromper normalmente.
+ *
+ *      Os handlers são instalados com irq_add_shared_handler(),
+ *      o que permite que outro código também use as linhas.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "dma_servico.h"
+
+#define NUM_LINHAS_DMA 2
+
+typedef struct {
+    const char *nome;
+    dma_servico_callback_t callback;
+    void *contexto;
+    uint8_t linha;
+    volatile uint32_t atendidas;
+} entrada_canal_t;
+
+static entrada_canal_t entradas[NUM_DMA_CHANNELS];
+static uint32_t canais_linha[NUM_LINHAS_DMA];   // Canais com callback em cada linha
+static bool handler_instalado[NUM_LINHAS_DMA];
+
+static void despachar(uint linha) {
+    uint32_t mascara = canais_linha[linha];
+    while (mascara) {
+        uint canal = (uint)__builtin_ctz(mascara);
+        mascara &= mascara - 1;
+
+        if (!dma_irqn_get_channel_status(linha, canal)) continue;
+        dma_irqn_acknowledge_channel(linha, canal);
+
+        entrada_canal_t *e = &entradas[canal];
+        e->atendidas++;
+        e->callback(canal, e->contexto);
+    }
+}
+
+static void handler_linha_0(void) {
+    despachar(0);
+}
+
+static void handler_linha_1(void) {
+    despachar(1);
+}
+
+uint dma_servico_reservar(const char *nome, uint linha, dma_servico_callback_t callback, void *contexto) {
+    uint canal = (uint)dma_claim_unused_channel(true);
+
+    entrada_canal_t *e = &entradas[canal];
+    e->nome = nome;
+    e->callback = callback;
+    e->contexto = contexto;
+    e->linha = (uint8_t)linha;
+    e->atendidas = 0;
+
+    if (callback) {
+        if (!handler_instalado[linha]) {
+            irq_add_shared_handler(linha ? DMA_IRQ_1 : DMA_IRQ_0,
+                                   linha ? handler_linha_1 : handler_linha_0,
+                                   PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+            handler_instalado[linha] = true;
+        }
+        dma_irqn_acknowledge_channel(linha, canal);
+        canais_linha[linha] |= 1u << canal;
+        dma_irqn_set_channel_enabled(linha, canal, true);
+    }
+    return canal;
+}
+
+void dma_servico_liberar(uint canal) {
+    entrada_canal_t *e = &entradas[canal];
+    if (e->callback) {
+        dma_irqn_set_channel_enabled(e->linha, canal, false);
+        canais_linha[e->linha] &= ~(1u << canal);
+        dma_irqn_acknowledge_channel(e->linha, canal);
+    }
+    e->nome = NULL;
+    e->callback = NULL;
+    dma_channel_unclaim(canal);
+}
+
+void dma_servico_habilitar_linha(uint linha) {
+    irq_set_enabled(linha ? DMA_IRQ_1 : DMA_IRQ_0, true);
+}
+
+void dma_servico_habilitar_canal(uint canal, bool ativo) {
+    const entrada_canal_t *e = &entradas[canal];
+    if (e->callback) dma_irqn_set_channel_enabled(e->linha, canal, ativo);
+}
+
+void dma_servico_descartar(uint32_t mascara) {
+    while (mascara) {
+        uint canal = (uint)__builtin_ctz(mascara);
+        mascara &= mascara - 1;
+        dma_irqn_acknowledge_channel(entradas[canal].linha, canal);
+    }
+}
+
+void dma_servico_imprimir(void) {
+    printf("dma:");
+    for (uint canal = 0; canal < NUM_DMA_CHANNELS; canal++) {
+        const entrada_canal_t *e = &entradas[canal];
+        if (!e->nome) continue;
+        if (e->callback) {
+            printf(" %u=%s/irq%u/%lu", canal, e->nome, e->linha, (unsigned long)e->atendidas);
+        } else {
+            printf(" %u=%s", canal, e->nome);
+        }
+    }
+    printf("\n");
+}
@@ -0,0 +1,92 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: dma_servico.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Serviço único de canais DMA, compartilhado pela
+ *      aquisição (ADC), pelo display (I2C) e pela matriz
+ *      (PIO).
+ *
+ *      Os canais são reservados com dma_claim_unused_channel(),
+ *      sem números fixos, e cada um pode registrar uma função
+ *      de conclusão. Um handler compartilhado por linha
+ *      (DMA_IRQ_0 e DMA_IRQ_1) verifica os canais da linha e
+ *      chama as funções dos que terminaram, já com o status
+ *      limpo.
+ *
+ *      A aquisição usa a linha 0, habilitada no núcleo que
+ *      roda a Tarefa 1; display e matriz usam a linha 1, no
+ *      núcleo 0. Assim o fim de bloco do ADC não espera pelos
+ *      callbacks de saída, e vice-versa.
+ *
+ *  Relacionamento:
+ *      - Canais do ADC reservados em 'setup.c', com os
+ *        callbacks de 'irq_handlers.c'.
+ *      - Canais do OLED (inc/ssd1306_i2c.c) e da matriz
+ *        (LabNeoPixel/neopixel_driver.c).
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef DMA_SERVICO_H
+#define DMA_SERVICO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+
+#define DMA_SERVICO_LINHA_AQUISICAO 0   // DMA_IRQ_0: ADC
+#define DMA_SERVICO_LINHA_SAIDA     1   // DMA_IRQ_1: OLED e NeoPixel
+
+/**
+ * @brief Função de conclusão, chamada no handler da linha do canal.
+ *
+ * @param canal Canal que terminou.
+ * @param contexto Valor passado a dma_servico_reservar().
+ */
+typedef void (*dma_servico_callback_t)(uint canal, void *contexto);
+
+/**
+ * @brief Reserva um canal livre e registra sua função de conclusão.
+ *
+ * Com 'callback' NULL o canal não gera interrupção. O handler da
+ * linha é instalado na primeira reserva; a habilitação no NVIC fica
+ * com dma_servico_habilitar_linha(). Sem canal livre, pára em panic.
+ *
+ * @param nome Dono do canal, para dma_servico_imprimir().
+ * @param linha DMA_SERVICO_LINHA_AQUISICAO ou DMA_SERVICO_LINHA_SAIDA.
+ * @return Número do canal.
+ */
+uint dma_servico_reservar(const char *nome, uint linha, dma_servico_callback_t callback, void *contexto);
+
+/**
+ * @brief Desliga a interrupção do canal e o devolve ao SDK.
+ */
+void dma_servico_liberar(uint canal);
+
+/**
+ * @brief Habilita a linha no NVIC do núcleo que chama.
+ */
+void dma_servico_habilitar_linha(uint linha);
+
+/**
+ * @brief Liga ou desliga a interrupção do canal na sua linha.
+ */
+void dma_servico_habilitar_canal(uint canal, bool ativo);
+
+/**
+ * @brief Limpa conclusões pendentes sem chamar os callbacks.
+ *
+ * @param mascara Bit i = canal i.
+ */
+void dma_servico_descartar(uint32_t mascara);
+
+/**
+ * @brief Imprime os canais reservados, linha e interrupções atendidas.
+ */
+void dma_servico_imprimir(void);
+
+#endif  // DMA_SERVICO_H
@@ -0,0 +1,192 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: escalonador.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Implementação do executor cíclico dirigido por tabela.
+ *      O callback do timer apenas incrementa o contador de
+ *      ticks; a liberação e a execução das tarefas acontecem
+ *      em escalonador_despachar(), fora do contexto de IRQ.
+ *
+ *      O instante de liberação de cada tick é calculado a
+ *      partir do início do executor (inicio + tick * tick_us),
+ *      de modo que o tempo de resposta não depende de quando
+ *      o laço principal percebeu o tick.
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include "hardware/timer.h"
+#include "hardware/sync.h"
+#include "escalonador.h"
+
+static tarefa_escalonada_t *tarefas;
+static uint8_t num_tarefas;
+static uint8_t ordem[ESCALONADOR_MAX_TAREFAS];   // Índices por prioridade
+
+static struct repeating_timer timer_tick;
+static absolute_time_t inicio;
+static uint32_t duracao_tick_us;
+static volatile uint32_t ticks_timer = 0;        // Escrito pelo callback
+static uint32_t ticks_processados = 0;
+static uint32_t ticks_atrasados = 0;
+static volatile uint32_t eventos = 0;            // Incrementado por escalonador_notificar()
+static uint32_t eventos_vistos = 0;
+static absolute_time_t inicio_medicao;
+static uint64_t ocioso_us = 0;
+
+static bool callback_tick(struct repeating_timer *timer) {
+    (void)timer;
+    // Atraso em relação ao instante ideal deste tick (inicio + n * tick_us)
+    uint64_t ideal = to_us_since_boot(inicio) + (uint64_t)ticks_timer * duracao_tick_us;
+    uint64_t agora = time_us_64();
+    estatistica_registrar(&estat_atraso_tick, agora > ideal ? (uint32_t)(agora - ideal) : 0);
+
+    ticks_timer++;
+    return true;
+}
+
+static void liberar_tick(uint32_t tick) {
+    absolute_time_t instante = delayed_by_us(inicio, (uint64_t)tick * duracao_tick_us);
+
+    for (uint8_t i = 0; i < num_tarefas; i++) {
+        tarefa_escalonada_t *tf = &tarefas[i];
+        if (tick % tf->periodo != tf->fase) continue;
+
+        if (tf->pendente) tf->sobreposicoes++;   // Instância anterior não rodou
+        tf->pendente = true;
+        tf->liberada_em = instante;
+    }
+}
+
+static void executar(tarefa_escalonada_t *tf) {
+    absolute_time_t ini = get_absolute_time();
+    tf->pendente = false;
+    tf->executar();
+    absolute_time_t fim = get_absolute_time();
+
+    tf->exec_us = (uint32_t)absolute_time_diff_us(ini, fim);
+    tf->resposta_us = (uint32_t)absolute_time_diff_us(tf->liberada_em, fim);
+    estatistica_registrar(&tf->exec, tf->exec_us);
+    estatistica_registrar(&tf->resposta, tf->resposta_us);
+    if (tf->prazo_us && tf->resposta_us > tf->prazo_us) tf->prazos_perdidos++;
+    tf->execucoes++;
+}
+
+bool escalonador_iniciar(tarefa_escalonada_t *tabela, uint8_t n, uint32_t tick_us) {
+    if (n > ESCALONADOR_MAX_TAREFAS) n = ESCALONADOR_MAX_TAREFAS;
+    tarefas = tabela;
+    num_tarefas = n;
+    duracao_tick_us = tick_us;
+
+    // Ordena os índices por prioridade (inserção; empate mantém a ordem da tabela)
+    for (uint8_t i = 0; i < n; i++) {
+        uint8_t j = i;
+        while (j > 0 && tabela[ordem[j - 1]].prioridade > tabela[i].prioridade) {
+            ordem[j] = ordem[j - 1];
+            j--;
+        }
+        ordem[j] = i;
+        tabela[i].pendente = false;
+        estatistica_zerar(&tabela[i].exec);
+        estatistica_zerar(&tabela[i].resposta);
+    }
+
+    // O tick 0 ocorre já na criação do timer; os seguintes a cada tick_us
+    inicio = get_absolute_time();
+    inicio_medicao = inicio;
+    ticks_timer = 1;
+    ticks_processados = 0;
+    return add_repeating_timer_us(-(int64_t)tick_us, callback_tick, NULL, &timer_tick);
+}
+
+void escalonador_despachar(void) {
+    eventos_vistos = eventos;
+    uint32_t alvo = ticks_timer;
+
+    // Mais de um tick por despacho significa que o laço ficou para trás
+    if (alvo - ticks_processados > 1) ticks_atrasados += alvo - ticks_processados - 1;
+    while (ticks_processados != alvo) {
+        liberar_tick(ticks_processados++);
+    }
+
+    for (uint8_t k = 0; k < num_tarefas; k++) {
+        tarefa_escalonada_t *tf = &tarefas[ordem[k]];
+        if (tf->pendente && (tf->pronta == NULL || tf->pronta())) {
+            executar(tf);
+        }
+    }
+}
+
+void escalonador_aguardar(void) {
+    // Com as interrupções desligadas, um IRQ que chegue entre a verificação
+    // e o __wfi() fica pendente e acorda o núcleo imediatamente; o handler
+    // roda ao religá-las.
+    uint32_t status = save_and_disable_interrupts();
+    if (ticks_timer == ticks_processados && eventos == eventos_vistos) {
+        absolute_time_t antes = get_absolute_time();
+        __wfi();
+        ocioso_us += absolute_time_diff_us(antes, get_absolute_time());
+    }
+    restore_interrupts(status);
+}
+
+void escalonador_notificar(void) {
+    eventos++;
+}
+
+int64_t escalonador_folga_us(const tarefa_escalonada_t *tf) {
+    if (!tf->prazo_us) return INT64_MAX;
+    return absolute_time_diff_us(get_absolute_time(), delayed_by_us(tf->liberada_em, tf->prazo_us));
+}
+
+uint32_t escalonador_ciclo_trabalho_permil(void) {
+    uint64_t total = absolute_time_diff_us(inicio_medicao, get_absolute_time());
+    if (total == 0) return 1000;
+    return (uint32_t)(1000 - ocioso_us * 1000 / total);
+}
+
+uint32_t escalonador_tick(void) {
+    return ticks_processados;
+}
+
+uint32_t escalonador_ticks_atrasados(void) {
+    return ticks_atrasados;
+}
+
+uint32_t escalonador_prazos_perdidos(void) {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < num_tarefas; i++) total += tarefas[i].prazos_perdidos;
+    return total;
+}
+
+void escalonador_imprimir_estatisticas(void) {
+    uint32_t cpu = escalonador_ciclo_trabalho_permil();
+    printf("ticks=%lu atrasados=%lu cpu=%lu.%lu%%\n", (unsigned long)ticks_processados,
+           (unsigned long)ticks_atrasados, (unsigned long)(cpu / 10), (unsigned long)(cpu % 10));
+    for (uint8_t i = 0; i < num_tarefas; i++) {
+        tarefa_escalonada_t *tf = &tarefas[i];
+        printf("%s: execucoes=%lu prazos_perdidos=%lu sobreposicoes=%lu\n",
+               tf->nome, (unsigned long)tf->execucoes,
+               (unsigned long)tf->prazos_perdidos, (unsigned long)tf->sobreposicoes);
+        estatistica_imprimir("  execucao", &tf->exec);
+        estatistica_imprimir("  resposta", &tf->resposta);
+    }
+}
+
+void escalonador_zerar_estatisticas(void) {
+    ticks_atrasados = 0;
+    ocioso_us = 0;
+    inicio_medicao = get_absolute_time();
+    for (uint8_t i = 0; i < num_tarefas; i++) {
+        tarefa_escalonada_t *tf = &tarefas[i];
+        tf->execucoes = tf->prazos_perdidos = tf->sobreposicoes = 0;
+        estatistica_zerar(&tf->exec);
+        estatistica_zerar(&tf->resposta);
+    }
+}
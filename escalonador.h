@@ -0,0 +1,137 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: escalonador.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Executor cíclico dirigido por tabela. O repeating_timer
+ *      gera um tick (quadro menor); cada tarefa da tabela é
+ *      liberada a cada 'periodo' ticks, a partir de 'fase', e
+ *      executada no laço principal em ordem de prioridade.
+ *      O quadro maior é o mínimo múltiplo comum dos períodos.
+ *
+ *      Uma tarefa pode ter uma guarda 'pronta': depois de
+ *      liberada ela fica pendente até a guarda retornar true
+ *      (ex.: Tarefa 1 concluída). Para cada execução são
+ *      registrados o tempo de execução e o tempo de resposta
+ *      (liberação → fim), com contagem de prazos perdidos e de
+ *      liberações sobrepostas (tarefa liberada de novo antes
+ *      de ter executado). O histórico de ambos os tempos fica em
+ *      estatistica_t (estatisticas.h), e o atraso do callback do
+ *      timer em relação a cada tick em estat_atraso_tick.
+ *
+ *      Sem trabalho pendente o laço principal dorme em
+ *      escalonador_aguardar() até o próximo IRQ (tick, DMA, USB);
+ *      o tempo dormindo dá o ciclo de trabalho da CPU.
+ *
+ *  Relacionamento:
+ *      - A tabela é definida por main.c
+ *      - Usa add_repeating_timer_us() do SDK
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef ESCALONADOR_H
+#define ESCALONADOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+#include "estatisticas.h"
+
+#define ESCALONADOR_MAX_TAREFAS 8
+
+typedef struct {
+    // Configuração (preenchida na tabela)
+    const char *nome;
+    void (*executar)(void);
+    bool (*pronta)(void);       // Guarda opcional (NULL = sempre pronta)
+    uint16_t periodo;           // Período em ticks
+    uint16_t fase;              // Tick da primeira liberação (< periodo)
+    uint32_t prazo_us;          // Prazo relativo à liberação (0 = sem prazo)
+    uint8_t prioridade;         // 0 = mais alta
+
+    // Estado e medições (mantidos pelo escalonador)
+    bool pendente;
+    absolute_time_t liberada_em;
+    uint32_t execucoes;
+    uint32_t prazos_perdidos;
+    uint32_t sobreposicoes;
+    uint32_t exec_us;           // Última duração da execução
+    uint32_t resposta_us;       // Último tempo liberação → fim
+    estatistica_t exec;         // Histórico da duração (WCET)
+    estatistica_t resposta;     // Histórico da resposta (jitter)
+} tarefa_escalonada_t;
+
+/**
+ * @brief Inicia o tick do executor.
+ *
+ * @param tabela  Tarefas (a tabela continua pertencendo a quem chama).
+ * @param n       Número de tarefas (até ESCALONADOR_MAX_TAREFAS).
+ * @param tick_us Duração do quadro menor.
+ * @return false se o timer não pôde ser criado.
+ */
+bool escalonador_iniciar(tarefa_escalonada_t *tabela, uint8_t n, uint32_t tick_us);
+
+/**
+ * @brief Libera as tarefas dos ticks decorridos e executa as pendentes.
+ *
+ * Deve ser chamada continuamente pelo laço principal.
+ */
+void escalonador_despachar(void);
+
+/**
+ * @brief Dorme (__wfi) até a próxima interrupção se não houver tick
+ *        nem evento novo desde o último despacho.
+ */
+void escalonador_aguardar(void);
+
+/**
+ * @brief Sinaliza, a partir de um IRQ, que alguma guarda pode ter
+ *        ficado verdadeira; impede que escalonador_aguardar() durma
+ *        sobre esse evento.
+ */
+void escalonador_notificar(void);
+
+/**
+ * @brief Tempo até o prazo da liberação atual de uma tarefa.
+ *
+ * @return Microssegundos até liberada_em + prazo_us (negativo se o
+ *         prazo já passou; INT64_MAX se a tarefa não tem prazo).
+ */
+int64_t escalonador_folga_us(const tarefa_escalonada_t *tf);
+
+/**
+ * @brief Fração do tempo acordado desde o início ou a última zeragem,
+ *        em milésimos.
+ */
+uint32_t escalonador_ciclo_trabalho_permil(void);
+
+/**
+ * @brief Número de ticks já processados.
+ */
+uint32_t escalonador_tick(void);
+
+/**
+ * @brief Ticks processados com atraso (o laço não acompanhou o timer).
+ */
+uint32_t escalonador_ticks_atrasados(void);
+
+/**
+ * @brief Soma dos prazos perdidos de todas as tarefas.
+ */
+uint32_t escalonador_prazos_perdidos(void);
+
+/**
+ * @brief Imprime contadores e estatísticas de cada tarefa.
+ */
+void escalonador_imprimir_estatisticas(void);
+
+/**
+ * @brief Zera contadores e estatísticas de todas as tarefas.
+ */
+void escalonador_zerar_estatisticas(void);
+
+#endif  // ESCALONADOR_H
@@ -0,0 +1,133 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: estatisticas.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Implementação das estatísticas de duração e dos
+ *      comandos de inspeção pela USB.
+ *
+ *      O atraso do tick é registrado no IRQ do timer, por isso
+ *      a zeragem desliga as interrupções. A latência do DMA é
+ *      registrada pelo núcleo que executa a Tarefa 1; no modo
+ *      TEMPCYCLE_MULTICORE uma zeragem simultânea pode perder
+ *      uma medição, o que é aceitável para diagnóstico.
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "hardware/watchdog.h"
+#include "estatisticas.h"
+#include "escalonador.h"
+#include "tarefa1_temp.h"
+#include "bench_ruido.h"
+#include "historico.h"
+#include "captura.h"
+#include "dma_servico.h"
+#include "ajustes.h"
+#include "setup.h"
+
+estatistica_t estat_atraso_tick = ESTATISTICA_INICIAL;
+estatistica_t estat_latencia_dma = ESTATISTICA_INICIAL;
+
+// Base do ciclo de trabalho do sensor (última zeragem)
+static uint64_t sensor_base_us = 0;
+static uint64_t sensor_inicio_us = 0;
+
+void estatistica_registrar(estatistica_t *e, uint32_t us) {
+    uint32_t k = us ? 32 - __builtin_clz(us) : 0;
+    if (k >= ESTAT_BALDES) k = ESTAT_BALDES - 1;
+
+    e->baldes[k]++;
+    e->n++;
+    e->soma_us += us;
+    if (us < e->min_us) e->min_us = us;
+    if (us > e->max_us) e->max_us = us;
+}
+
+void estatistica_zerar(estatistica_t *e) {
+    uint32_t status = save_and_disable_interrupts();
+    memset(e, 0, sizeof(*e));
+    e->min_us = UINT32_MAX;
+    restore_interrupts(status);
+}
+
+uint32_t estatistica_media_us(const estatistica_t *e) {
+    return e->n ? (uint32_t)(e->soma_us / e->n) : 0;
+}
+
+void estatistica_imprimir(const char *nome, const estatistica_t *e) {
+    // Cópia consistente: a original pode ser atualizada em IRQ
+    uint32_t status = save_and_disable_interrupts();
+    estatistica_t c = *e;
+    restore_interrupts(status);
+
+    if (c.n == 0) {
+        printf("%-14s n=0\n", nome);
+        return;
+    }
+
+    printf("%-14s n=%lu min=%luus med=%luus max=%luus |",
+           nome, (unsigned long)c.n, (unsigned long)c.min_us,
+           (unsigned long)estatistica_media_us(&c), (unsigned long)c.max_us);
+
+    // Apenas baldes não vazios, pelo limite superior: "<2^k:contagem"
+    for (uint32_t k = 0; k < ESTAT_BALDES; k++) {
+        if (!c.baldes[k]) continue;
+        if (k == ESTAT_BALDES - 1) printf(" >=2^%lu:%lu", (unsigned long)(k - 1), (unsigned long)c.baldes[k]);
+        else                       printf(" <2^%lu:%lu", (unsigned long)k, (unsigned long)c.baldes[k]);
+    }
+    printf("\n");
+}
+
+void estatisticas_imprimir_tudo(void) {
+    printf("--- Estatisticas (us) ---\n");
+    estatistica_imprimir("atraso tick", &estat_atraso_tick);
+    estatistica_imprimir("latencia DMA", &estat_latencia_dma);
+    escalonador_imprimir_estatisticas();
+
+    uint64_t total = time_us_64() - sensor_inicio_us;
+    uint64_t ligado = tarefa1_tempo_sensor_ligado_us() - sensor_base_us;
+    uint32_t permil = total ? (uint32_t)(ligado * 1000 / total) : 0;
+    printf("sensor/ADC ligado=%lu.%lu%%\n", (unsigned long)(permil / 10), (unsigned long)(permil % 10));
+    printf("janelas encurtadas=%lu reset por watchdog=%s\n",
+           (unsigned long)tarefa1_janelas_encurtadas(), watchdog_caused_reboot() ? "sim" : "nao");
+    historico_imprimir_estado();
+    captura_imprimir_estado();
+    dma_servico_imprimir();
+    setup_imprimir_boot();
+}
+
+void estatisticas_zerar_tudo(void) {
+    estatistica_zerar(&estat_atraso_tick);
+    estatistica_zerar(&estat_latencia_dma);
+    escalonador_zerar_estatisticas();
+    sensor_base_us = tarefa1_tempo_sensor_ligado_us();
+    sensor_inicio_us = time_us_64();
+    printf("Estatisticas zeradas\n");
+}
+
+void estatisticas_processar_comandos(void) {
+    int c;
+    while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+        // Teclas únicas só fora de uma linha do shell de ajustes
+        if (!ajustes_linha_em_andamento()) {
+            switch (c) {
+                case 's': estatisticas_imprimir_tudo(); continue;
+                case 'r': estatisticas_zerar_tudo();    continue;
+                case 'b': bench_ruido_executar(10);     continue;
+                case 'h': historico_exportar();         continue;
+                case 'c': captura_alternar();           continue;
+                default: break;
+            }
+        }
+        ajustes_receber((char)c);
+    }
+    ajustes_servico();
+}
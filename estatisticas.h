@@ -0,0 +1,83 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: estatisticas.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Estatísticas de duração (mín/máx/média e histograma em
+ *      baldes log2) para dimensionar o ciclo pelo pior caso.
+ *
+ *      O balde k conta as medições em [2^(k-1), 2^k) µs; o
+ *      balde 0 conta as de 0 µs e o último acumula todas as
+ *      maiores. Registrar é O(1) e pode ser feito em IRQ.
+ *
+ *      Instrumentos globais:
+ *        - estat_atraso_tick:  atraso do callback do timer do
+ *                              escalonador em relação ao tick
+ *        - estat_latencia_dma: fim de bloco no IRQ do DMA até a
+ *                              Tarefa 1 acordar e percebê-lo
+ *      As tarefas da tabela têm as próprias estatísticas de
+ *      execução e de resposta (escalonador.h).
+ *
+ *      O despejo inclui também o ciclo de trabalho da CPU
+ *      (tempo fora do __wfi) e o do ADC/sensor desde a última
+ *      zeragem.
+ *
+ *      Comandos pela USB (estatisticas_processar_comandos):
+ *        's' imprime todas as estatísticas
+ *        'r' zera todos os contadores
+ *        'b' executa o benchmark de ruído da Tarefa 1
+ *            (bench_ruido.c; bloqueia por ~35 s)
+ *        'h' envia o histórico gravado na flash (historico.h)
+ *        'c' liga/desliga a captura das amostras brutas do
+ *            ADC (captura.h)
+ *      Fora de uma linha começada, esses caracteres são
+ *      comandos; os demais vão para o shell de ajustes
+ *      (ajustes.h), que recebe a linha inteira.
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+#include <stdint.h>
+
+#define ESTAT_BALDES 24   // Último balde: ≥ 2^22 µs (~4,2 s)
+
+typedef struct {
+    uint32_t n;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t soma_us;
+    uint32_t baldes[ESTAT_BALDES];
+} estatistica_t;
+
+#define ESTATISTICA_INICIAL { .min_us = UINT32_MAX }
+
+extern estatistica_t estat_atraso_tick;
+extern estatistica_t estat_latencia_dma;
+
+void estatistica_registrar(estatistica_t *e, uint32_t us);
+void estatistica_zerar(estatistica_t *e);
+uint32_t estatistica_media_us(const estatistica_t *e);
+void estatistica_imprimir(const char *nome, const estatistica_t *e);
+
+/**
+ * @brief Imprime os instrumentos globais e as tarefas do escalonador.
+ */
+void estatisticas_imprimir_tudo(void);
+
+/**
+ * @brief Zera os instrumentos globais e as tarefas do escalonador.
+ */
+void estatisticas_zerar_tudo(void);
+
+/**
+ * @brief Lê os comandos pendentes da USB sem bloquear.
+ */
+void estatisticas_processar_comandos(void);
+
+#endif  // ESTATISTICAS_H
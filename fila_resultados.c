@@ -0,0 +1,61 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: fila_resultados.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Implementação da fila SPSC de resultados entre os
+ *      núcleos. Cada índice só é escrito por um dos lados:
+ *      'cabeca' pelo produtor e 'cauda' pelo consumidor. As
+ *      barreiras de memória garantem que o conteúdo da posição
+ *      esteja visível antes do índice que o publica.
+ *
+ *      Após publicar, o produtor executa __sev() para acordar
+ *      o núcleo 0 de um eventual __wfe().
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "fila_resultados.h"
+
+static resultado_ciclo_t itens[FILA_RESULTADOS_TAMANHO];
+static volatile uint32_t cabeca = 0;       // Próxima posição a escrever
+static volatile uint32_t cauda = 0;        // Próxima posição a ler
+static volatile uint32_t descartados = 0;
+
+bool fila_resultados_publicar(const resultado_ciclo_t *r) {
+    uint32_t c = cabeca;
+    if (c - cauda == FILA_RESULTADOS_TAMANHO) {
+        descartados++;
+        return false;
+    }
+
+    itens[c % FILA_RESULTADOS_TAMANHO] = *r;
+    __dmb();            // Conteúdo visível antes do novo índice
+    cabeca = c + 1;
+    __sev();
+    return true;
+}
+
+bool fila_resultados_consumir(resultado_ciclo_t *r) {
+    uint32_t t = cauda;
+    if (cabeca == t) return false;
+
+    __dmb();            // Índice lido antes do conteúdo
+    *r = itens[t % FILA_RESULTADOS_TAMANHO];
+    __dmb();            // Conteúdo copiado antes de liberar a posição
+    cauda = t + 1;
+    return true;
+}
+
+bool fila_resultados_disponivel(void) {
+    return cabeca != cauda;
+}
+
+uint32_t fila_resultados_descartados(void) {
+    return descartados;
+}
@@ -0,0 +1,66 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: fila_resultados.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Fila circular sem trava (um produtor, um consumidor)
+ *      para publicar os resultados de cada ciclo do núcleo 1
+ *      (aquisição + tendência) para o núcleo 0 (display e
+ *      NeoPixel).
+ *
+ *      Apenas o núcleo 1 chama fila_resultados_publicar() e
+ *      apenas o núcleo 0 chama fila_resultados_consumir().
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef FILA_RESULTADOS_H
+#define FILA_RESULTADOS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "tarefa3_tendencia.h"
+
+#define FILA_RESULTADOS_TAMANHO 8   // Potência de 2
+
+// Resultado de um ciclo de aquisição e análise
+typedef struct {
+    int32_t media_centi;      // Temperatura média (centésimos de °C)
+    tendencia_t tendencia;    // Tendência calculada pela Tarefa 3
+    int32_t minimo_centi;     // Extremos da janela da Tarefa 3 (escala do gráfico)
+    int32_t maximo_centi;
+    uint64_t timestamp_us;    // Fim da janela de aquisição
+    uint32_t amostras;        // Amostras somadas na janela
+    uint16_t media_bruta_q4;  // Média do código do ADC × 16
+    uint32_t tempo_t1_us;     // Duração da Tarefa 1
+    uint32_t tempo_t3_us;     // Duração da Tarefa 3
+} resultado_ciclo_t;
+
+/**
+ * @brief Publica um resultado (lado produtor).
+ *
+ * @return false se a fila estiver cheia; o resultado é descartado.
+ */
+bool fila_resultados_publicar(const resultado_ciclo_t *r);
+
+/**
+ * @brief Retira o resultado mais antigo (lado consumidor).
+ *
+ * @return false se a fila estiver vazia.
+ */
+bool fila_resultados_consumir(resultado_ciclo_t *r);
+
+/**
+ * @brief Indica se há resultado a consumir (lado consumidor).
+ */
+bool fila_resultados_disponivel(void);
+
+/**
+ * @brief Número de resultados descartados por fila cheia.
+ */
+uint32_t fila_resultados_descartados(void);
+
+#endif  // FILA_RESULTADOS_H
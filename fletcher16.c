@@ -0,0 +1,40 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: fletcher16.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Fletcher-16 com a redução módulo 255 adiada: as somas
+ *      cabem em 32 bits por até FLETCHER16_TRECHO bytes.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include "fletcher16.h"
+
+#define FLETCHER16_TRECHO 5802   // Maior n com 255 × n(n+1)/2 + s2 < 2^32
+
+uint16_t fletcher16(const void *dados, uint32_t n) {
+    const uint8_t *p = dados;
+    uint32_t s1 = 0, s2 = 0;
+    while (n) {
+        uint32_t trecho = n < FLETCHER16_TRECHO ? n : FLETCHER16_TRECHO;
+        n -= trecho;
+        while (trecho--) {
+            s1 += *p++;
+            s2 += s1;
+        }
+        s1 %= 255;
+        s2 %= 255;
+    }
+    return (uint16_t)((s2 << 8) | s1);
+}
+
+uint16_t fletcher16_juntar(uint16_t a, uint16_t b, uint32_t n_b) {
+    uint32_t a1 = a & 0xFF, a2 = a >> 8;
+    uint32_t s1 = (a1 + (b & 0xFF)) % 255;
+    uint32_t s2 = (a2 + (b >> 8) + (n_b % 255) * a1) % 255;
+    return (uint16_t)((s2 << 8) | s1);
+}
@@ -0,0 +1,34 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: fletcher16.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Soma de verificação Fletcher-16 dos formatos gravados e
+ *      enviados pela USB (telemetria, histórico, perfil de
+ *      ajustes e captura): duas somas módulo 255, a segunda
+ *      no byte alto.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef FLETCHER16_H
+#define FLETCHER16_H
+
+#include <stdint.h>
+
+/**
+ * @brief Fletcher-16 de 'n' bytes.
+ */
+uint16_t fletcher16(const void *dados, uint32_t n);
+
+/**
+ * @brief Soma de 'a' seguido de 'b', a partir das somas de cada um.
+ *
+ * @param n_b Bytes cobertos por 'b'.
+ */
+uint16_t fletcher16_juntar(uint16_t a, uint16_t b, uint32_t n_b);
+
+#endif  // FLETCHER16_H
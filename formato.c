@@ -0,0 +1,59 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: formato.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Conversão de ponto fixo para texto (formato.h): o número
+ *      é montado da direita para a esquerda em um buffer local
+ *      e copiado para a saída com a unidade.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include "formato.h"
+
+static const uint32_t potencias_10[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+};
+
+size_t formatar_fixo(char *saida, size_t tamanho, int32_t valor, uint8_t casas_valor,
+                     uint8_t casas, uint8_t opcoes, const char *unidade) {
+    if (tamanho == 0) return 0;
+    if (casas_valor > 9) casas_valor = 9;
+    if (casas > casas_valor) casas = casas_valor;
+
+    bool negativo = valor < 0;
+    uint32_t modulo = negativo ? 0u - (uint32_t)valor : (uint32_t)valor;
+
+    // Descarta as casas a mais, arredondando a metade para longe do zero
+    uint32_t divisor = potencias_10[casas_valor - casas];
+    if (divisor > 1) {
+        uint32_t resto = modulo % divisor;
+        modulo /= divisor;
+        if (resto >= divisor - divisor / 2) modulo++;
+    }
+    if (modulo == 0) negativo = false;
+
+    char tmp[FORMATO_TAMANHO_MAX];
+    char *p = tmp + sizeof(tmp);
+    *--p = '\0';
+    int digitos = 0;
+    do {
+        if (digitos == casas && casas > 0) *--p = '.';
+        *--p = (char)('0' + modulo % 10);
+        modulo /= 10;
+        digitos++;
+    } while (modulo != 0 || digitos <= casas);   // Ao menos um dígito antes do ponto
+    if (negativo) *--p = '-';
+    else if (opcoes & FORMATO_SINAL) *--p = '+';
+
+    size_t n = 0;
+    while (*p && n + 1 < tamanho) saida[n++] = *p++;
+    while (unidade && *unidade && n + 1 < tamanho) saida[n++] = *unidade++;
+    saida[n] = '\0';
+    return n;
+}
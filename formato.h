@@ -0,0 +1,58 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: formato.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Formatação de números em ponto fixo, só com inteiros,
+ *      para o display e as linhas de texto pela USB.
+ *
+ *      Com ela nenhum caminho do firmware usa %f, e a parte
+ *      de ponto flutuante do printf do SDK fica fora da imagem
+ *      (PICO_PRINTF_SUPPORT_FLOAT=0 no CMakeLists.txt): a
+ *      conversão pelo printf custa vários KB de flash e
+ *      milhares de ciclos por chamada no M0+, contra algumas
+ *      divisões inteiras pelo divisor do SIO aqui.
+ *
+ *  Relacionamento:
+ *      - Valor grande do OLED ('inc/display_utils.c'), linha
+ *        de texto do ciclo ('main.c') e bancada de ruído
+ *        ('bench_ruido.c').
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef FORMATO_H
+#define FORMATO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FORMATO_SINAL  0x01    // '+' também em valores positivos e no zero
+
+#define FORMATO_TAMANHO_MAX 16 // Maior número formatado, sem a unidade, com o '\0'
+
+/**
+ * @brief Escreve um valor em ponto fixo com 'casas' decimais.
+ *
+ * 'valor' tem 'casas_valor' casas decimais implícitas (centésimos: 2,
+ * microssegundos como segundos: 6). Com menos casas na saída, arredonda
+ * para longe do zero; o sinal é o do valor arredondado, e '-' nunca
+ * aparece antes de um zero. Saída curta demais trunca o texto, sempre
+ * com '\0'.
+ *
+ * @param saida        Destino do texto.
+ * @param tamanho      Bytes disponíveis em 'saida', com o '\0'.
+ * @param valor        Número com 'casas_valor' casas implícitas.
+ * @param casas_valor  Casas decimais de 'valor' (até 9).
+ * @param casas        Casas na saída (até 'casas_valor').
+ * @param opcoes       FORMATO_SINAL ou 0.
+ * @param unidade      Texto acrescentado ao número, ou NULL.
+ * @return Comprimento do texto escrito, sem o '\0'.
+ */
+size_t formatar_fixo(char *saida, size_t tamanho, int32_t valor, uint8_t casas_valor,
+                     uint8_t casas, uint8_t opcoes, const char *unidade);
+
+#endif  // FORMATO_H
@@ -0,0 +1,266 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: historico.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Implementação do histórico em flash (historico.h).
+ *
+ *      A escrita avança página a página pela região circular;
+ *      ao entrar em um setor ele é apagado junto com a
+ *      programação da primeira página. A página em RAM só é
+ *      reaproveitada depois de gravada: enquanto ela espera,
+ *      novos registros são descartados e contados.
+ *
+ *      O envio pela USB copia cada página para a RAM antes de
+ *      transmiti-la, porque um apagamento pode atingir o setor
+ *      mais antigo durante o envio.
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "usb_binario.h"
+#include "historico.h"
+#include "fletcher16.h"
+
+static historico_pagina_t pagina;          // Página em preenchimento
+static uint32_t n_registros = 0;
+static bool pendente = false;              // Página cheia aguardando gravação
+static bool ativo = false;
+
+static uint32_t proxima_pagina = 0;        // Índice na região, 0..HISTORICO_PAGINAS-1
+static uint32_t proxima_sequencia = 0;
+static uint8_t inicializacao = 0;
+
+static uint32_t gravadas = 0;
+static uint32_t apagamentos = 0;
+static uint32_t descartados = 0;
+static uint32_t falhas = 0;
+
+// Envio pela USB
+static bool exportando = false;
+static uint32_t exp_inicio = 0;
+static uint32_t exp_indice = 0;            // HISTORICO_PAGINAS = página em RAM
+static uint32_t exp_enviados = 0;          // Bytes já enviados de 'copia'
+static historico_pagina_t copia;
+
+static uint16_t verificacao(const historico_pagina_t *p) {
+    return fletcher16(&p->sequencia,
+                      sizeof(*p) - offsetof(historico_pagina_t, sequencia));
+}
+
+static uintptr_t endereco_flash(uint32_t indice) {
+    return (uintptr_t)XIP_BASE + HISTORICO_FLASH_OFFSET + indice * FLASH_PAGE_SIZE;
+}
+
+static const historico_pagina_t *pagina_flash(uint32_t indice) {
+    return (const historico_pagina_t *)endereco_flash(indice);
+}
+
+static bool pagina_valida(const historico_pagina_t *p) {
+    return p->magica == HISTORICO_MAGICA && p->verificacao == verificacao(p);
+}
+
+static bool pagina_apagada(uint32_t indice) {
+    const uint32_t *w = (const uint32_t *)endereco_flash(indice);
+    for (uint32_t i = 0; i < FLASH_PAGE_SIZE / 4; i++) {
+        if (w[i] != 0xFFFFFFFFu) return false;
+    }
+    return true;
+}
+
+static void preparar_pagina(void) {
+    memset(&pagina, 0xFF, sizeof(pagina));
+    n_registros = 0;
+}
+
+void historico_iniciar(void) {
+    preparar_pagina();
+
+    if (!mapa_flash_livre(HISTORICO_FLASH_OFFSET)) {
+        ativo = false;   // A imagem invade a região reservada
+        return;
+    }
+    ativo = true;
+
+    // Setor mais recente: maior sequência entre as primeiras páginas
+    int32_t recente = -1;
+    uint32_t seq_recente = 0;
+    for (uint32_t s = 0; s < HISTORICO_SETORES; s++) {
+        const historico_pagina_t *p = pagina_flash(s * HISTORICO_PAGINAS_SETOR);
+        if (!pagina_valida(p)) continue;
+        if (recente < 0 || (int32_t)(p->sequencia - seq_recente) > 0) {
+            recente = (int32_t)s;
+            seq_recente = p->sequencia;
+        }
+    }
+
+    if (recente < 0) {   // Região vazia ou nunca usada
+        proxima_pagina = 0;
+        proxima_sequencia = 0;
+        inicializacao = 0;
+        return;
+    }
+
+    // Páginas consecutivas do setor mais recente
+    uint32_t base = (uint32_t)recente * HISTORICO_PAGINAS_SETOR;
+    uint32_t k = 0;
+    while (k + 1 < HISTORICO_PAGINAS_SETOR) {
+        const historico_pagina_t *p = pagina_flash(base + k + 1);
+        if (!pagina_valida(p) || p->sequencia != seq_recente + k + 1) break;
+        k++;
+    }
+
+    const historico_pagina_t *ultima = pagina_flash(base + k);
+    proxima_sequencia = ultima->sequencia + 1;
+    inicializacao = (uint8_t)(ultima->registros[HISTORICO_REGISTROS_PAGINA - 1].inicializacao + 1);
+
+    // Uma página parcialmente programada (queda de energia) não pode ser
+    // reescrita sem apagar o setor: a escrita continua no setor seguinte.
+    if (k + 1 < HISTORICO_PAGINAS_SETOR && pagina_apagada(base + k + 1)) {
+        proxima_pagina = base + k + 1;
+    } else {
+        proxima_pagina = (base + HISTORICO_PAGINAS_SETOR) % HISTORICO_PAGINAS;
+    }
+}
+
+bool historico_registrar(uint32_t timestamp_ms, int32_t media_centi, uint8_t tendencia) {
+    if (!ativo || pendente) {
+        descartados++;
+        return false;
+    }
+
+    historico_registro_t *r = &pagina.registros[n_registros++];
+    r->timestamp_ms = timestamp_ms;
+    r->media_centi = (int16_t)media_centi;
+    r->tendencia = tendencia;
+    r->inicializacao = inicializacao;
+
+    if (n_registros == HISTORICO_REGISTROS_PAGINA) {
+        pagina.magica = HISTORICO_MAGICA;
+        pagina.sequencia = proxima_sequencia;
+        pagina.verificacao = verificacao(&pagina);
+        pendente = true;
+    }
+    return true;
+}
+
+bool historico_gravacao_pendente(void) {
+    return pendente;
+}
+
+// Executada com o outro núcleo estacionado e as interrupções desligadas;
+// flash_range_erase/program saem do XIP e rodam a partir da RAM.
+static void programar_pagina(void *param) {
+    uint32_t offset = *(const uint32_t *)param;
+    if (offset % FLASH_SECTOR_SIZE == 0) {
+        flash_range_erase(offset, FLASH_SECTOR_SIZE);
+    }
+    flash_range_program(offset, (const uint8_t *)&pagina, FLASH_PAGE_SIZE);
+}
+
+void historico_gravar(void) {
+    if (!pendente) return;
+
+    uint32_t offset = HISTORICO_FLASH_OFFSET + proxima_pagina * FLASH_PAGE_SIZE;
+    if (flash_safe_execute(programar_pagina, &offset, MAPA_FLASH_TIMEOUT_MS) != PICO_OK) {
+        falhas++;   // Tenta de novo na próxima liberação
+        return;
+    }
+
+    if (offset % FLASH_SECTOR_SIZE == 0) apagamentos++;
+    gravadas++;
+    proxima_pagina = (proxima_pagina + 1) % HISTORICO_PAGINAS;
+    proxima_sequencia++;
+    pendente = false;
+    preparar_pagina();
+}
+
+void historico_exportar(void) {
+    if (!ativo) return;
+
+    // A mais antiga começa no primeiro setor a partir do ponto de escrita
+    // (o próprio setor, se a escrita ainda não entrou nele).
+    uint32_t resto = proxima_pagina % HISTORICO_PAGINAS_SETOR;
+    exp_inicio = resto ? (proxima_pagina - resto + HISTORICO_PAGINAS_SETOR) % HISTORICO_PAGINAS
+                       : proxima_pagina;
+    exp_indice = 0;
+    exp_enviados = sizeof(copia);   // Nenhuma página carregada
+    exportando = true;
+}
+
+bool historico_exportando(void) {
+    return exportando;
+}
+
+// Carrega em 'copia' a próxima página a enviar; false ao terminar.
+static bool carregar_proxima(void) {
+    while (exp_indice < HISTORICO_PAGINAS) {
+        const historico_pagina_t *p = pagina_flash((exp_inicio + exp_indice) % HISTORICO_PAGINAS);
+        exp_indice++;
+        if (pagina_valida(p)) {
+            memcpy(&copia, p, sizeof(copia));
+            return true;
+        }
+    }
+
+    // Por último, a página em RAM (mesma sequência que terá ao ser gravada)
+    if (exp_indice == HISTORICO_PAGINAS) {
+        exp_indice++;
+        if (n_registros > 0) {
+            copia = pagina;
+            copia.magica = HISTORICO_MAGICA;
+            copia.sequencia = proxima_sequencia;
+            copia.verificacao = verificacao(&copia);
+            return true;
+        }
+    }
+    return false;
+}
+
+void historico_exportar_servico(void) {
+    if (!exportando) return;
+    if (!usb_binario_conectado()) {
+        exportando = false;
+        return;
+    }
+
+    // A página sai em pedaços do tamanho do espaço livre: a telemetria está
+    // suspensa e nada mais escreve na USB durante o envio (usb_binario.h)
+    while (true) {
+        if (exp_enviados == sizeof(copia)) {
+            if (!carregar_proxima()) {
+                exportando = false;
+                break;
+            }
+            exp_enviados = 0;
+        }
+
+        uint32_t livre = usb_binario_livre();
+        if (livre == 0) break;
+
+        uint32_t resta = sizeof(copia) - exp_enviados;
+        uint32_t n = resta < livre ? resta : livre;
+        usb_binario_escrever((const uint8_t *)&copia + exp_enviados, n);
+        exp_enviados += n;
+    }
+}
+
+void historico_imprimir_estado(void) {
+    if (!ativo) {
+        printf("historico: desativado (imagem sobre a regiao)\n");
+        return;
+    }
+    printf("historico: boot=%u pagina=%lu seq=%lu gravadas=%lu apagamentos=%lu descartados=%lu falhas=%lu\n",
+           inicializacao, (unsigned long)proxima_pagina, (unsigned long)proxima_sequencia,
+           (unsigned long)gravadas, (unsigned long)apagamentos,
+           (unsigned long)descartados, (unsigned long)falhas);
+}
@@ -0,0 +1,123 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: historico.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Histórico das leituras de cada ciclo gravado na flash,
+ *      para não perder dados quando não há USB conectada.
+ *
+ *      Os registros {instante, média, tendência} são juntados
+ *      em uma página de 256 bytes na RAM e só a página cheia é
+ *      programada. A região usa HISTORICO_SETORES setores de
+ *      4 KB logo abaixo do setor de calibração, percorridos em
+ *      círculo: cada setor só é apagado quando a escrita volta
+ *      a ele, o que distribui os apagamentos por igual.
+ *
+ *      Formato da página (little-endian, 256 bytes):
+ *        u16 magica       HISTORICO_MAGICA
+ *        u16 fletcher16   sobre os 252 bytes seguintes
+ *        u32 sequencia    incrementa a cada página gravada
+ *        31 × registro:
+ *          u32 timestamp_ms  desde o boot
+ *          i16 media_centi   centésimos de °C
+ *          u8  tendencia     tendencia_t
+ *          u8  inicializacao boot em que foi gravado (mod 256)
+ *      Posições não usadas ficam apagadas (0xFF).
+ *
+ *      No boot basta ler a primeira página de cada setor para
+ *      achar o mais recente pela sequência, e então as páginas
+ *      dele até a primeira apagada.
+ *
+ *      Pela USB, 'h' envia todas as páginas válidas, da mais
+ *      antiga para a mais recente, seguidas da página em RAM
+ *      ainda não gravada (tools/ler_historico.py).
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef HISTORICO_H
+#define HISTORICO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hardware/flash.h"
+#include "mapa_flash.h"
+
+// HISTORICO_SETORES e HISTORICO_FLASH_OFFSET em mapa_flash.h
+#define HISTORICO_MAGICA    0x4853     // "SH" em little-endian
+#define HISTORICO_REGISTROS_PAGINA 31
+#define HISTORICO_PAGINAS_SETOR (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)
+#define HISTORICO_PAGINAS   (HISTORICO_SETORES * HISTORICO_PAGINAS_SETOR)
+
+typedef struct __attribute__((packed)) {
+    uint32_t timestamp_ms;
+    int16_t media_centi;
+    uint8_t tendencia;
+    uint8_t inicializacao;
+} historico_registro_t;
+
+typedef struct __attribute__((packed)) {
+    uint16_t magica;
+    uint16_t verificacao;
+    uint32_t sequencia;
+    historico_registro_t registros[HISTORICO_REGISTROS_PAGINA];
+} historico_pagina_t;
+
+_Static_assert(sizeof(historico_pagina_t) == FLASH_PAGE_SIZE, "página do histórico deve ter 256 bytes");
+
+/**
+ * @brief Localiza a última página gravada e o ponto de escrita.
+ *
+ * Se a imagem do firmware invadir a região, o histórico fica
+ * desativado e os registros são descartados.
+ */
+void historico_iniciar(void);
+
+/**
+ * @brief Acrescenta um registro à página em RAM. Não grava na flash.
+ *
+ * @return false se a página anterior ainda aguarda gravação
+ *         (registro descartado).
+ */
+bool historico_registrar(uint32_t timestamp_ms, int32_t media_centi, uint8_t tendencia);
+
+/**
+ * @brief Indica se há uma página cheia aguardando gravação.
+ */
+bool historico_gravacao_pendente(void);
+
+/**
+ * @brief Grava a página pendente, apagando o setor quando ela é a
+ *        primeira dele.
+ *
+ * A flash fica inacessível durante a operação (~1 ms por página,
+ * ~45 ms com apagamento): roda por flash_safe_execute(), que
+ * estaciona o núcleo 1 e desliga as interrupções. Em caso de falha
+ * a página continua pendente.
+ */
+void historico_gravar(void);
+
+/**
+ * @brief Inicia o envio do histórico pela USB.
+ */
+void historico_exportar(void);
+
+/**
+ * @brief Indica se há um envio em andamento.
+ */
+bool historico_exportando(void);
+
+/**
+ * @brief Envia à USB o que couber no espaço livre de transmissão.
+ */
+void historico_exportar_servico(void);
+
+/**
+ * @brief Imprime páginas gravadas, apagamentos, descartes e falhas.
+ */
+void historico_imprimir_estado(void);
+
+#endif  // HISTORICO_H
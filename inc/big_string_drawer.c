@@ -1,24 +1,26 @@
-#include "font_big_logo.h"
+#include "font_big_paginada.h"
 #include "draw_big_char.h"
+#include "big_string_drawer.h"
 #include <stddef.h>
+#include <string.h>
 
 const uint8_t* get_big_bitmap(char c) {
     switch (c) {
-        case '0': return big_digit_0;
-        case '1': return big_digit_1;
-        case '2': return big_digit_2;
-        case '3': return big_digit_3;
-        case '4': return big_digit_4;
-        case '5': return big_digit_5;
-        case '6': return big_digit_6;
-        case '7': return big_digit_7;
-        case '8': return big_digit_8;
-        case '9': return big_digit_9;
-        case '+': return big_char_plus;
-        case '-': return big_char_minus;
-        case '.': return big_char_dot;
-        case 'o': return big_char_degree;
-        case 'C': return big_char_C;
+        case '0': return big_digit_0_pag;
+        case '1': return big_digit_1_pag;
+        case '2': return big_digit_2_pag;
+        case '3': return big_digit_3_pag;
+        case '4': return big_digit_4_pag;
+        case '5': return big_digit_5_pag;
+        case '6': return big_digit_6_pag;
+        case '7': return big_digit_7_pag;
+        case '8': return big_digit_8_pag;
+        case '9': return big_digit_9_pag;
+        case '+': return big_char_plus_pag;
+        case '-': return big_char_minus_pag;
+        case '.': return big_char_dot_pag;
+        case 'o': return big_char_degree_pag;
+        case 'C': return big_char_C_pag;
         default: return NULL;
     }
 }
@@ -42,15 +44,37 @@ int calc_string_width(const char *str) {
     return width;
 }
 
-void draw_big_string_aligned_right(uint8_t *ssd, int y, const char *str) {
-    int width = calc_string_width(str);
-    int x = 128 - width;
-    while (*str) {
-        const uint8_t *bitmap = get_big_bitmap(*str);
-        if (bitmap) {
-            draw_big_char(ssd, x, y, bitmap);
+int draw_big_string_aligned_right(uint8_t *ssd, int y, const char *str) {
+    return draw_big_string_changed(ssd, y, str, "");
+}
+
+int draw_big_string_changed(uint8_t *ssd, int y, const char *str, const char *anterior) {
+    static const uint8_t vazio[BIG_CHAR_LARGURA * BIG_CHAR_ALTURA / 8];
+    int x = 128 - calc_string_width(str);
+    int x_anterior = 128 - calc_string_width(anterior);
+
+    // Mesmo comprimento e largura: cada caractere fica na mesma posição
+    bool alinhado = x == x_anterior && strlen(str) == strlen(anterior);
+    if (!alinhado) {
+        // Apaga o que o texto anterior ocupava à esquerda do novo
+        for (int xa = x_anterior; xa < x; xa += BIG_CHAR_LARGURA) {
+            draw_big_char(ssd, xa, y, vazio);
         }
-        x += get_char_width(*str);
-        str++;
     }
+
+    int desenhados = 0;
+    bool cobriu = false;   // O glifo anterior (16 px) passou da sua largura
+    for (; *str; str++, anterior += alinhado) {
+        int largura = get_char_width(*str);
+        if (!alinhado || cobriu || *str != *anterior) {
+            const uint8_t *bitmap = get_big_bitmap(*str);
+            draw_big_char(ssd, x, y, bitmap ? bitmap : vazio);
+            desenhados++;
+            cobriu = largura < BIG_CHAR_LARGURA;
+        } else {
+            cobriu = false;
+        }
+        x += largura;
+    }
+    return desenhados;
 }
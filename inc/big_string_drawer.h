@@ -1,8 +1,17 @@
 #ifndef BIG_STRING_DRAWER_H
 #define BIG_STRING_DRAWER_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
-void draw_big_string_aligned_right(uint8_t *ssd, int y, const char *str);
+// Desenha 'str' na fonte grande, alinhado à direita, a partir da linha y.
+// Retorna o número de glifos desenhados.
+int draw_big_string_aligned_right(uint8_t *ssd, int y, const char *str);
+
+// Redesenha sobre 'anterior', o texto que já está na mesma linha: com o
+// mesmo comprimento e largura, só os caracteres que mudaram (e o seguinte
+// a um glifo estreito, que o cobre); senão, todos, e as colunas que o
+// texto anterior ocupava à esquerda ficam apagadas.
+int draw_big_string_changed(uint8_t *ssd, int y, const char *str, const char *anterior);
 
 #endif
\ No newline at end of file
@@ -1,10 +1,15 @@
-#include <stdio.h>
+#include <string.h>
 #include <stdint.h>
 #include "display_utils.h"
 #include "big_string_drawer.h"
 
-void mostrar_valor_grande(uint8_t *ssd, float valor, int y) {
-    char buffer[16];
-    snprintf(buffer, sizeof(buffer), "%+.1foC", valor);
-    draw_big_string_aligned_right(ssd, y, buffer);
+int mostrar_valor_grande(uint8_t *ssd, valor_grande_t *cache, int32_t centi, int y) {
+    char buffer[sizeof(cache->texto)];
+    formatar_fixo(buffer, sizeof(buffer), centi, 2, 1, FORMATO_SINAL, "oC");
+    if (cache == NULL) return draw_big_string_aligned_right(ssd, y, buffer);
+
+    if (strcmp(buffer, cache->texto) == 0) return 0;
+    int desenhados = draw_big_string_changed(ssd, y, buffer, cache->texto);
+    memcpy(cache->texto, buffer, sizeof(buffer));
+    return desenhados;
 }
\ No newline at end of file
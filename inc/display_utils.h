@@ -2,7 +2,17 @@
 #define DISPLAY_UTILS_H
 
 #include <stdint.h>
+#include "formato.h"
 
-void mostrar_valor_grande(uint8_t *ssd, float valor, int y);
+// Último texto do valor grande desenhado em um ponto do quadro
+typedef struct {
+    char texto[FORMATO_TAMANHO_MAX + 2];   // Mais a unidade "oC"; "" = nada desenhado
+} valor_grande_t;
+
+// Desenha a temperatura (centésimos de °C) com sinal, uma casa e "oC", na fonte
+// grande e alinhada à direita. Com 'cache', só os glifos que mudaram desde o
+// último desenho; zerar cache->texto força o desenho completo depois de a área
+// ser apagada. Retorna o número de glifos desenhados (0 = texto igual).
+int mostrar_valor_grande(uint8_t *ssd, valor_grande_t *cache, int32_t centi, int y);
 
 #endif
\ No newline at end of file
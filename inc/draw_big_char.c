@@ -0,0 +1,51 @@
+#include <string.h>
+#include "ssd1306.h"
+#include "draw_big_char.h"
+
+#define GLIFO_PAGINAS (BIG_CHAR_ALTURA / 8)
+
+// Desenha um caractere grande no buffer ssd[] a partir de um glifo paginado.
+// Com y múltiplo de 8, cada página do glifo coincide com uma página do
+// display e o desenho se reduz a um memcpy de 16 bytes por página. Nos demais
+// casos, cada página do display recebe a parte de baixo de uma página do
+// glifo e a parte de cima da seguinte, preservando os bits fora do retângulo.
+void draw_big_char(uint8_t *ssd, int x, int y, const uint8_t *glifo) {
+    if (y < 0 || y >= ssd1306_height) return;
+
+    // Recorte horizontal
+    int col_ini = x < 0 ? -x : 0;
+    int col_fim = x + BIG_CHAR_LARGURA > ssd1306_width ? ssd1306_width - x : BIG_CHAR_LARGURA;
+    if (col_ini >= col_fim) return;
+    int largura = col_fim - col_ini;
+
+    int pagina = y / 8;
+    int deslocamento = y % 8;
+
+    if (deslocamento == 0) {
+        for (int p = 0; p < GLIFO_PAGINAS && pagina + p < ssd1306_n_pages; p++) {
+            uint8_t *destino = ssd + (pagina + p) * ssd1306_width + x + col_ini;
+            memcpy(destino, glifo + p * BIG_CHAR_LARGURA + col_ini, largura);
+            ssd1306_mark_dirty(pagina + p, x + col_ini, x + col_fim - 1);
+        }
+        return;
+    }
+
+    // O glifo ocupa GLIFO_PAGINAS + 1 páginas do display
+    for (int q = 0; q <= GLIFO_PAGINAS && pagina + q < ssd1306_n_pages; q++) {
+        uint8_t mascara = 0xFF;
+        if (q == 0) mascara = 0xFF << deslocamento;
+        if (q == GLIFO_PAGINAS) mascara = 0xFF >> (8 - deslocamento);
+
+        const uint8_t *cima = q > 0 ? glifo + (q - 1) * BIG_CHAR_LARGURA : NULL;
+        const uint8_t *baixo = q < GLIFO_PAGINAS ? glifo + q * BIG_CHAR_LARGURA : NULL;
+        uint8_t *destino = ssd + (pagina + q) * ssd1306_width + x;
+
+        for (int col = col_ini; col < col_fim; col++) {
+            uint8_t valor = 0;
+            if (baixo) valor |= baixo[col] << deslocamento;
+            if (cima) valor |= cima[col] >> (8 - deslocamento);
+            destino[col] = (destino[col] & ~mascara) | (valor & mascara);
+        }
+        ssd1306_mark_dirty(pagina + q, x + col_ini, x + col_fim - 1);
+    }
+}
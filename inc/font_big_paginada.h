@@ -0,0 +1,28 @@
+#ifndef FONT_BIG_PAGINADA_H
+#define FONT_BIG_PAGINADA_H
+#include <stdint.h>
+
+// Fonte grande no formato de páginas do SSD1306: 4 páginas x 16 colunas,
+// glifo[pagina * 16 + coluna]. Gerada na compilação a partir de
+// font_big_logo_data.c por tools/gerar_fonte_paginada.py.
+
+// Caracteres especiais
+extern const uint8_t big_char_plus_pag[64];
+extern const uint8_t big_char_minus_pag[64];
+extern const uint8_t big_char_dot_pag[64];
+extern const uint8_t big_char_degree_pag[64];
+extern const uint8_t big_char_C_pag[64];
+
+// Dígitos de 0 a 9
+extern const uint8_t big_digit_0_pag[64];
+extern const uint8_t big_digit_1_pag[64];
+extern const uint8_t big_digit_2_pag[64];
+extern const uint8_t big_digit_3_pag[64];
+extern const uint8_t big_digit_4_pag[64];
+extern const uint8_t big_digit_5_pag[64];
+extern const uint8_t big_digit_6_pag[64];
+extern const uint8_t big_digit_7_pag[64];
+extern const uint8_t big_digit_8_pag[64];
+extern const uint8_t big_digit_9_pag[64];
+
+#endif
\ No newline at end of file
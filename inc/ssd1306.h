@@ -16,4 +16,13 @@ extern void ssd1306_config(ssd1306_t *ssd);
 extern void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 extern void ssd1306_send_data(ssd1306_t *ssd);
 extern void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap);
-extern void ssd1306_clear_display(uint8_t *ssd);
\ No newline at end of file
+extern void ssd1306_clear_display(uint8_t *ssd);
+extern void ssd1306_clear_buffer(uint8_t *ssd);
+extern void ssd1306_mark_dirty(int page, int col_ini, int col_fim);
+extern void ssd1306_mark_all_dirty(void);
+extern int ssd1306_flush(uint8_t *ssd);
+extern void ssd1306_async_init(void);
+extern bool ssd1306_async_busy(void);
+extern bool ssd1306_async_take_error(void);
+extern bool ssd1306_flush_async(uint8_t *ssd);
+extern uint32_t ssd1306_bytes_enviados(void);
\ No newline at end of file
@@ -5,8 +5,64 @@
 #include "pico/stdlib.h"
 #include "pico/binary_info.h"
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
 #include "ssd1306_font.h"
 #include "ssd1306_i2c.h"
+#include "dma_servico.h"
+
+// Rastreamento de alterações do framebuffer do display (ssd[]).
+// Para cada página, guarda o intervalo de colunas tocado pelas primitivas
+// desde o último flush; 'sombra' guarda o que já está no painel, para que o
+// flush envie apenas as colunas que de fato mudaram.
+static uint8_t sujo_ini[ssd1306_n_pages];
+static uint8_t sujo_fim[ssd1306_n_pages];
+static bool sujo[ssd1306_n_pages];
+static uint8_t sombra[ssd1306_buffer_length];
+static bool sombra_valida = false;
+
+// Envio assíncrono: o quadro é convertido num fluxo de palavras de 16 bits
+// para IC_DATA_CMD (byte + bit de STOP ao fim de cada transação) e empurrado
+// no FIFO de TX do i2c1 por um canal DMA cadenciado pelo DREQ do I2C.
+// Pior caso: todas as páginas com comandos (7) + controle e 128 colunas.
+#define ASYNC_MAX_PALAVRAS (ssd1306_n_pages * (7 + 1 + ssd1306_width))
+static uint16_t async_fluxo[ASYNC_MAX_PALAVRAS];
+static int async_canal = -1;
+static bool async_erro = false;
+
+// Bytes escritos no barramento (controle + dados), para os benchmarks
+static uint32_t bytes_barramento = 0;
+
+bool ssd1306_async_busy(void);
+
+// Aguarda o fim de um envio assíncrono antes de qualquer escrita bloqueante
+static void ssd1306_async_wait(void) {
+    while (ssd1306_async_busy()) tight_loop_contents();
+}
+
+// Marca como alterado o intervalo [col_ini, col_fim] de uma página
+void ssd1306_mark_dirty(int page, int col_ini, int col_fim) {
+    if (page < 0 || page >= ssd1306_n_pages) return;
+    if (col_ini < 0) col_ini = 0;
+    if (col_fim > ssd1306_width - 1) col_fim = ssd1306_width - 1;
+    if (col_ini > col_fim) return;
+
+    if (!sujo[page]) {
+        sujo[page] = true;
+        sujo_ini[page] = col_ini;
+        sujo_fim[page] = col_fim;
+    } else {
+        if (col_ini < sujo_ini[page]) sujo_ini[page] = col_ini;
+        if (col_fim > sujo_fim[page]) sujo_fim[page] = col_fim;
+    }
+}
+
+// Força o reenvio completo no próximo flush (conteúdo do painel desconhecido)
+void ssd1306_mark_all_dirty(void) {
+    for (int page = 0; page < ssd1306_n_pages; page++) {
+        ssd1306_mark_dirty(page, 0, ssd1306_width - 1);
+    }
+    sombra_valida = false;
+}
 
 // Calcular quanto do buffer será destinado à área de renderização
 void calculate_render_area_buffer_length(struct render_area *area) {
@@ -16,26 +72,40 @@ void calculate_render_area_buffer_length(struct render_area *area) {
 // Processo de escrita do i2c espera um byte de controle, seguido por dados
 void ssd1306_send_command(uint8_t command) {
     uint8_t buffer[2] = {0x80, command};
+    ssd1306_async_wait();
     i2c_write_blocking(i2c1, ssd1306_i2c_address, buffer, 2, false);
+    bytes_barramento += 2;
 }
 
-// Envia uma lista de comandos ao hardware
+// Envia uma lista de comandos ao hardware numa única transação: com o byte de
+// controle 0x00 (Co = 0, D/C = 0), todos os bytes seguintes são comandos
+#define COMMAND_LIST_CHUNK 32
 void ssd1306_send_command_list(uint8_t *ssd, int number) {
-    for (int i = 0; i < number; i++) {
-        ssd1306_send_command(ssd[i]);
+    uint8_t buffer[1 + COMMAND_LIST_CHUNK];
+    buffer[0] = 0x00;
+
+    ssd1306_async_wait();
+    for (int i = 0; i < number; i += COMMAND_LIST_CHUNK) {
+        int n = number - i < COMMAND_LIST_CHUNK ? number - i : COMMAND_LIST_CHUNK;
+        memcpy(buffer + 1, ssd + i, n);
+        i2c_write_blocking(i2c1, ssd1306_i2c_address, buffer, n + 1, false);
+        bytes_barramento += n + 1;
     }
 }
 
-// Copia buffer de referência num novo buffer, a fim de adicionar o byte de controle desde o início
+// Envia os dados direto do framebuffer, sem cópia. O byte anterior a ssd[0]
+// é usado temporariamente como byte de controle 0x40, por isso o framebuffer
+// deve reservar uma posição antes do início (ver 'ssd' em setup.c); para
+// regiões no meio do quadro, o byte anterior é salvo e restaurado.
 void ssd1306_send_buffer(uint8_t ssd[], int buffer_length) {
-    uint8_t *temp_buffer = malloc(buffer_length + 1);
-
-    temp_buffer[0] = 0x40;
-    memcpy(temp_buffer + 1, ssd, buffer_length);
-
-    i2c_write_blocking(i2c1, ssd1306_i2c_address, temp_buffer, buffer_length + 1, false);
-
-    free(temp_buffer);
+    uint8_t *inicio = ssd - 1;
+    uint8_t salvo = *inicio;
+
+    ssd1306_async_wait();
+    *inicio = 0x40;
+    i2c_write_blocking(i2c1, ssd1306_i2c_address, inicio, buffer_length + 1, false);
+    *inicio = salvo;
+    bytes_barramento += buffer_length + 1;
 }
 
 // Cria a lista de comandos (com base nos endereços definidos em ssd1306_i2c.h) para a inicialização do display
@@ -62,6 +132,7 @@ void ssd1306_init() {
     };
 
     ssd1306_send_command_list(commands, count_of(commands));
+    ssd1306_mark_all_dirty();  // RAM do painel com conteúdo indefinido
 }
 
 // Cria a lista de comandos para configurar o scrolling
@@ -85,6 +156,140 @@ void render_on_display(uint8_t *ssd, struct render_area *area) {
     ssd1306_send_buffer(ssd, area->buffer_length);
 }
 
+// Retira a marca de uma página e reduz o intervalo às colunas que diferem do
+// painel; atualiza a sombra. Retorna false se nada precisa ser enviado.
+static bool ssd1306_take_dirty(uint8_t *ssd, int page, int *ini, int *fim) {
+    if (!sujo[page]) return false;
+    sujo[page] = false;
+
+    uint8_t *linha = ssd + page * ssd1306_width;
+    uint8_t *linha_sombra = sombra + page * ssd1306_width;
+    int i = sujo_ini[page];
+    int f = sujo_fim[page];
+
+    // Descarta as bordas que já coincidem com o painel
+    if (sombra_valida) {
+        while (i <= f && linha[i] == linha_sombra[i]) i++;
+        while (f >= i && linha[f] == linha_sombra[f]) f--;
+        if (i > f) return false;
+    }
+
+    memcpy(linha_sombra + i, linha + i, f - i + 1);
+    *ini = i;
+    *fim = f;
+    return true;
+}
+
+// Envia apenas as regiões alteradas desde o último flush; retorna os bytes de dados enviados
+int ssd1306_flush(uint8_t *ssd) {
+    int enviados = 0;
+    int ini, fim;
+
+    for (int page = 0; page < ssd1306_n_pages; page++) {
+        if (!ssd1306_take_dirty(ssd, page, &ini, &fim)) continue;
+
+        struct render_area regiao = {
+            .start_column = ini,
+            .end_column = fim,
+            .start_page = page,
+            .end_page = page
+        };
+        calculate_render_area_buffer_length(&regiao);
+        render_on_display(ssd + page * ssd1306_width + ini, &regiao);
+        enviados += regiao.buffer_length;
+    }
+
+    sombra_valida = true;
+    return enviados;
+}
+
+// Reserva o canal DMA do envio assíncrono; chamar após ssd1306_init().
+// Sem callback: o fim do envio é o do barramento, verificado por
+// ssd1306_async_busy(), e não o do DMA.
+void ssd1306_async_init(void) {
+    if (async_canal >= 0) return;
+    async_canal = (int)dma_servico_reservar("oled", DMA_SERVICO_LINHA_SAIDA, NULL, NULL);
+}
+
+// Indica se há um envio assíncrono em andamento (DMA ou barramento)
+bool ssd1306_async_busy(void) {
+    if (async_canal < 0) return false;
+
+    i2c_hw_t *hw = i2c_get_hw(i2c1);
+
+    // NACK ou perda de arbitragem: o controlador descarta o FIFO e para
+    if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+        dma_channel_abort(async_canal);
+        (void)hw->clr_tx_abrt;
+        async_erro = true;
+        return false;
+    }
+
+    if (dma_channel_is_busy(async_canal)) return true;
+    return !(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_ACTIVITY_BITS);
+}
+
+// Indica (e limpa) se o último envio assíncrono foi abortado pelo barramento
+bool ssd1306_async_take_error(void) {
+    bool erro = async_erro;
+    async_erro = false;
+    if (erro) ssd1306_mark_all_dirty();  // Conteúdo do painel incerto
+    return erro;
+}
+
+// Acrescenta uma transação ao fluxo: byte de controle, bytes e STOP no último
+static int ssd1306_async_append(int n, uint8_t controle, const uint8_t *bytes, int len) {
+    async_fluxo[n++] = controle;
+    for (int i = 0; i < len; i++) {
+        async_fluxo[n++] = bytes[i];
+    }
+    async_fluxo[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+    return n;
+}
+
+// Versão não bloqueante de ssd1306_flush(): monta o fluxo das regiões
+// alteradas e dispara o DMA. Retorna false se ainda houver envio em
+// andamento (as marcas são mantidas para a próxima chamada).
+bool ssd1306_flush_async(uint8_t *ssd) {
+    if (async_canal < 0) {
+        ssd1306_flush(ssd);
+        return true;
+    }
+    if (ssd1306_async_busy()) return false;
+
+    int n = 0;
+    int ini, fim;
+
+    for (int page = 0; page < ssd1306_n_pages; page++) {
+        if (!ssd1306_take_dirty(ssd, page, &ini, &fim)) continue;
+
+        // Lista de comandos numa única transação (controle 0x00)
+        uint8_t commands[] = {
+            ssd1306_set_column_address, ini, fim,
+            ssd1306_set_page_address, page, page
+        };
+        n = ssd1306_async_append(n, 0x00, commands, count_of(commands));
+        n = ssd1306_async_append(n, 0x40, ssd + page * ssd1306_width + ini, fim - ini + 1);
+    }
+    sombra_valida = true;
+
+    if (n == 0) return true;
+
+    i2c_hw_t *hw = i2c_get_hw(i2c1);
+    hw->enable = 0;
+    hw->tar = ssd1306_i2c_address;
+    hw->enable = 1;
+
+    dma_channel_config cfg = dma_channel_get_default_config(async_canal);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, i2c_get_dreq(i2c1, true));
+    dma_channel_configure(async_canal, &cfg, &hw->data_cmd, async_fluxo, n, true);
+    bytes_barramento += n;
+    return true;
+}
+
 // Determina o pixel a ser aceso (no display) de acordo com a coordenada fornecida
 void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set) {
     assert(x >= 0 && x < ssd1306_width && y >= 0 && y < ssd1306_height);
@@ -101,7 +306,10 @@ void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set) {
         byte &= ~(1 << (y % 8));
     }
 
-    ssd[byte_idx] = byte;
+    if (byte != ssd[byte_idx]) {
+        ssd[byte_idx] = byte;
+        ssd1306_mark_dirty(y / 8, x, x);
+    }
 }
 
 // Algoritmo de Bresenham básico
@@ -133,7 +341,7 @@ void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool se
 }
 
 // Adquire os pixels para um caractere (de acordo com ssd1306_font.h)
-inline int ssd1306_get_font(uint8_t character)
+static inline int ssd1306_get_font(uint8_t character)
 {
   if (character >= 'A' && character <= 'Z') {
     return character - 'A' + 1;
@@ -160,6 +368,7 @@ void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
     for (int i = 0; i < 8; i++) {
         ssd[fb_idx++] = font[idx * 8 + i];
     }
+    ssd1306_mark_dirty(y, x, x + 7);
 }
 
 // Desenha uma string, chamando a função de desenhar caractere várias vezes
@@ -244,14 +453,21 @@ void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap) {
     }
 }
 
+uint32_t ssd1306_bytes_enviados(void) {
+    return bytes_barramento;
+}
+
+// Limpa o buffer e o painel inteiro (envio completo)
 void ssd1306_clear_display(uint8_t *ssd) {
     memset(ssd, 0, ssd1306_buffer_length);
-    struct render_area area = {
-        .start_column = 0,
-        .end_column = ssd1306_width - 1,
-        .start_page = 0,
-        .end_page = ssd1306_n_pages - 1
-    };
-    calculate_render_area_buffer_length(&area);
-    render_on_display(ssd, &area);
+    ssd1306_mark_all_dirty();
+    ssd1306_flush(ssd);
+}
+
+// Limpa apenas o buffer em RAM; o painel só muda no próximo flush
+void ssd1306_clear_buffer(uint8_t *ssd) {
+    memset(ssd, 0, ssd1306_buffer_length);
+    for (int page = 0; page < ssd1306_n_pages; page++) {
+        ssd1306_mark_dirty(page, 0, ssd1306_width - 1);
+    }
 }
@@ -1,45 +1,108 @@
-/**
- * ------------------------------------------------------------
- *  Arquivo: irq_handlers.c
- *  Projeto: TempCycleDMA
- * ------------------------------------------------------------
- *  Descrição:
- *      Este arquivo implementa o handler de interrupção do
- *      canal DMA 0, utilizado para leitura do sensor interno
- *      de temperatura via ADC do Raspberry Pi Pico W.
- *
- *      A função 'dma_handler_temp()' é responsável por
- *      capturar a interrupção do DMA, limpar o status e
- *      sinalizar a finalização da transferência de dados
- *      via flag global 'dma_temp_done'.
- *
- *  Relacionamento:
- *      - Este handler é registrado em 'setup.c' usando:
- *            irq_set_exclusive_handler(DMA_IRQ_0, dma_handler_temp);
- *      - A flag 'dma_temp_done' é usada em 'tarefa1_temp.c'
- *        para controlar o fluxo da aquisição via DMA.
- *
- *  
- *  Data: 11/05/2025
- * ------------------------------------------------------------
- */
-
-#include "hardware/dma.h"
-#include "irq_handlers.h"
-
-// Flag global que sinaliza a conclusão da transferência DMA
-volatile bool dma_temp_done = false;
-
-/**
- * @brief Handler de interrupção do canal DMA 0.
- *
- * Esta função é chamada automaticamente quando o canal 0 do DMA
- * completa a transferência das amostras do ADC para o buffer.
- * Ela limpa a flag da interrupção e ativa o sinalizador
- * 'dma_temp_done' para que o laço principal saiba que pode
- * prosseguir.
- */
-void dma_handler_temp() {
-    dma_hw->ints0 = 1u << 0;   // Limpa a interrupção do canal 0
-    dma_temp_done = true;     // Sinaliza conclusão para o executor
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: irq_handlers.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Este arquivo implementa o tratamento de conclusão dos
+ *      dois canais DMA utilizados em ping-pong para leitura
+ *      do sensor interno de temperatura via ADC do Raspberry
+ *      Pi Pico W.
+ *
+ *      A função 'dma_temp_bloco_concluido()' é chamada pelo
+ *      serviço de DMA com o status já limpo, e é responsável
+ *      por rearmar o endereço de escrita do canal que terminou
+ *      (para o próximo encadeamento) e sinalizar qual metade
+ *      do buffer está pronta via 'dma_temp_blocos_prontos'.
+ *
+ *      Com TAREFA1_USAR_SNIFFER, o mesmo handler acumula a
+ *      soma do sniffer em 'dma_temp_soma_bruta' a cada bloco
+ *      e re-dispara o canal enquanto a janela estiver aberta.
+ *
+ *  Relacionamento:
+ *      - Esta função é registrada em 'setup.c' ao reservar os
+ *        canais com dma_servico_reservar(), na linha
+ *        DMA_SERVICO_LINHA_AQUISICAO (DMA_IRQ_0).
+ *      - A flag 'dma_temp_done' e o instante 'dma_temp_irq_us'
+ *        são usados em 'tarefa1_temp.c' para medir a latência
+ *        entre o fim de bloco e a Tarefa 1 percebê-lo.
+ *
+ *  
+ *  Data: 11/05/2025
+ * ------------------------------------------------------------
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "irq_handlers.h"
+#include "setup.h"
+#include "escalonador.h"
+
+// Flag global que sinaliza a conclusão de alguma transferência DMA
+volatile bool dma_temp_done = false;
+
+// Instante (time_us_32) do último fim de bloco, para medir a latência até a Tarefa 1
+volatile uint32_t dma_temp_irq_us = 0;
+
+// Bit i ligado = metade i do ping-pong cheia e ainda não reduzida
+volatile uint32_t dma_temp_blocos_prontos = 0;
+
+// Blocos sobrescritos antes de a Tarefa 1 consumi-los
+volatile uint32_t dma_temp_blocos_perdidos = 0;
+
+// Fins de bloco desde o boot (nunca zerado): diz à captura até quando uma
+// metade já entregue ainda não foi reescrita
+volatile uint32_t dma_temp_blocos_concluidos = 0;
+
+// Início de cada metade do buffer, definido pela Tarefa 1
+uint16_t *dma_temp_destino[2];
+
+// Soma bruta e número de amostras acumulados pelo sniffer
+volatile uint64_t dma_temp_soma_bruta = 0;
+volatile uint32_t dma_temp_amostras = 0;
+
+// Enquanto verdadeiro, cada fim de bloco re-dispara o canal do sniffer
+volatile bool dma_temp_sniffer_ativo = false;
+
+// Transferências por bloco do sniffer, definido pela Tarefa 1
+uint32_t dma_temp_bloco = 0;
+
+/**
+ * @brief Conclusão de bloco de um dos canais do ADC.
+ *
+ * Esta função é chamada pelo handler da linha de aquisição quando um
+ * dos canais do ping-pong completa seu bloco. O outro canal já foi
+ * disparado pelo encadeamento, então aqui basta devolver o endereço
+ * de escrita do canal que terminou ao início da sua metade, de forma
+ * que ele esteja pronto quando for disparado de novo, e marcar a
+ * metade como pronta para a Tarefa 1.
+ *
+ * @param canal Canal que terminou.
+ * @param contexto Metade do buffer (0 ou 1) servida pelo canal.
+ */
+void dma_temp_bloco_concluido(uint canal, void *contexto) {
+#if TAREFA1_USAR_SNIFFER
+    (void)contexto;
+
+    // A soma é lida e zerada antes do re-disparo, com o canal parado
+    dma_temp_soma_bruta += dma_hw->sniff_data;
+    dma_hw->sniff_data = 0;
+    dma_temp_amostras += dma_temp_bloco;
+
+    if (dma_temp_sniffer_ativo) {
+        dma_channel_set_trans_count(canal, dma_temp_bloco, true);
+    }
+#else
+    uint i = (uint)(uintptr_t)contexto;
+    dma_channel_set_write_addr(canal, dma_temp_destino[i], false);
+
+    if (dma_temp_blocos_prontos & (1u << i)) {
+        dma_temp_blocos_perdidos++;   // Tarefa 1 não acompanhou
+    }
+    dma_temp_blocos_prontos |= 1u << i;
+    dma_temp_blocos_concluidos++;
+#endif
+    dma_temp_irq_us = time_us_32();
+    dma_temp_done = true;     // Sinaliza conclusão para o executor
+    escalonador_notificar();  // Não dormir com um bloco a reduzir
 }
\ No newline at end of file
@@ -1,9 +1,22 @@
-#ifndef IRQ_HANDLERS_H
-#define IRQ_HANDLERS_H
-
-#include <stdbool.h>
-
-extern volatile bool dma_temp_done;
-void dma_handler_temp(void);
-
+#ifndef IRQ_HANDLERS_H
+#define IRQ_HANDLERS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+
+extern volatile bool dma_temp_done;
+extern volatile uint32_t dma_temp_irq_us;
+extern volatile uint32_t dma_temp_blocos_prontos;
+extern volatile uint32_t dma_temp_blocos_perdidos;
+extern volatile uint32_t dma_temp_blocos_concluidos;
+extern uint16_t *dma_temp_destino[2];
+
+// Estado do modo sniffer (TAREFA1_USAR_SNIFFER)
+extern volatile uint64_t dma_temp_soma_bruta;
+extern volatile uint32_t dma_temp_amostras;
+extern volatile bool dma_temp_sniffer_ativo;
+extern uint32_t dma_temp_bloco;
+void dma_temp_bloco_concluido(uint canal, void *contexto);
+
 #endif
\ No newline at end of file
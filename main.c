@@ -1,158 +1,454 @@
-/**
- * ------------------------------------------------------------
- * Arquivo: main.c
- * Projeto: TempCycleDMA
- * ------------------------------------------------------------
- * Descrição:
- * Ciclo principal do sistema embarcado, baseado em um
- * executor cíclico com tarefas principais:
- *
- * Tarefa 1 - Leitura da temperatura via DMA 
- * Tarefa 2 - Exibição da temperatura e tendência no OLED 
- * Tarefa 3 - Análise da tendência da temperatura 
- * Tarefa 4 - Controle NeoPixel baseado na tendência
- *
- * O sistema utiliza um repeating_timer para iniciar o ciclo
- * de tarefas. As tarefas são executadas sequencialmente
- * após a conclusão da Tarefa 1.
- *
- * MODIFICAÇÃO PRINCIPAL: O ciclo de execução das tarefas agora é
- * disparado por uma flag (g_executar_ciclo_tarefas) que é
- * ativada por um repeating_timer, em vez de um sleep_ms() fixo
- * ao final do loop principal. Isso proporciona um início de ciclo
- * mais preciso e desacopla o tempo de espera da execução das tarefas.
- * ------------------------------------------------------------
- */
-
-#include <stdio.h>
-#include "pico/stdlib.h"
-#include "hardware/watchdog.h"
-#include "hardware/timer.h"   // Para add_repeating_timer_ms
-
-#include "setup.h"           // Para cfg_temp e setup()
-#include "tarefa1_temp.h"
-#include "tarefa2_display.h"
-#include "tarefa3_tendencia.h"
-#include "tarefa4_controla_neopixel.h"
-#include "neopixel_driver.h"
-#include "testes_cores.h"
-#include "pico/stdio_usb.h" 
-
-// Variáveis globais para dados entre tarefas e medição de tempo
-float media;
-tendencia_t t;
-absolute_time_t ini_tarefa1, fim_tarefa1, ini_tarefa2, fim_tarefa2, ini_tarefa3, fim_tarefa3, ini_tarefa4, fim_tarefa4;
-
-// --- MODIFICAÇÃO: Flag global para ser acionada pelo repeating_timer ---
-// Esta flag controla quando o bloco principal de tarefas deve ser executado.
-volatile bool g_executar_ciclo_tarefas = false;
-
-// --- MODIFICAÇÃO: Callback do repeating_timer ---
-// Esta função é chamada pelo hardware timer em intervalos regulares.
-// Sua única responsabilidade é sinalizar que um novo ciclo de tarefas deve começar.
-bool repeating_timer_callback_principal(struct repeating_timer *timer) {
-    (void)timer; // Evita warning de parâmetro não usado se 'timer' não for utilizado no corpo.
-    g_executar_ciclo_tarefas = true; // Ativa a flag para o loop principal.
-    return true; // Retorna true para que o timer continue repetindo.
-}
-
-// Protótipos das funções que encapsulam as chamadas de tarefa originais
-// Essas "wrappers" ajudam a organizar o código e manter a lógica de medição de tempo.
-void executar_tarefa_1_leitura_temp(void);
-void executar_tarefa_2_analise_tendencia(void); 
-void executar_tarefa_3_display_oled(void);      
-void executar_tarefa_4_controle_neopixel(void);
-void executar_tarefa_5_extra_neopixel(void);
-
-int main() {
-    setup(); // Chama a função de configuração inicial do hardware e periféricos.
-
-    // --- MODIFICAÇÃO: Configuração do repeating_timer ---
-    struct repeating_timer timer_ciclo;
-    // Adiciona um timer que chama 'repeating_timer_callback_principal' a cada 1000 ms.
-    // O valor -1000 ms significa que o primeiro callback ocorrerá "imediatamente"
-    // (após a inicialização do timer) e depois a cada 1000ms.
-    // Se a função falhar ao adicionar o timer, imprime um erro e entra em loop infinito.
-    if (!add_repeating_timer_ms(-1000, repeating_timer_callback_principal, NULL, &timer_ciclo)) {
-        printf("Falha ao adicionar o timer principal!\n");
-        while(1) {
-            tight_loop_contents(); // Loop de erro simples.
-        }
-    }
-
-    // --- MODIFICAÇÃO: Loop principal agora é orientado por flag ---
-    while (true) { // Loop infinito principal do programa.
-
-        // Verifica se a flag foi ativada pelo callback do timer.
-        if (g_executar_ciclo_tarefas) {
-            g_executar_ciclo_tarefas = false; // Reseta a flag para o próximo ciclo.
-
-            // Executa as tarefas sequencialmente.
-            executar_tarefa_1_leitura_temp();
-            executar_tarefa_5_extra_neopixel();
-            executar_tarefa_2_analise_tendencia(); 
-            executar_tarefa_3_display_oled();      
-            executar_tarefa_4_controle_neopixel();
-
-            // Calcula a duração de cada tarefa.
-            int64_t tempo1_us = absolute_time_diff_us(ini_tarefa1, fim_tarefa1);
-            int64_t tempo2_us = absolute_time_diff_us(ini_tarefa2, fim_tarefa2); 
-            int64_t tempo3_us = absolute_time_diff_us(ini_tarefa3, fim_tarefa3); 
-            int64_t tempo4_us = absolute_time_diff_us(ini_tarefa4, fim_tarefa4);
-
-            // Imprime os resultados e tempos no terminal serial USB.
-            printf("Temperatura: %.2f C | T1(Leitura): %.3fs | T_Disp: %.3fs | T_Tend: %.3fs | T_NeoP: %.3fs | Tend: %s\n",
-                   media,
-                   tempo1_us / 1e6,
-                   tempo2_us / 1e6, 
-                   tempo3_us / 1e6, 
-                   tempo4_us / 1e6,
-                   tendencia_para_texto(t));
-        } else {
-        }
-    }
-
-    return 0; 
-}
-
-void executar_tarefa_1_leitura_temp() {
-    ini_tarefa1 = get_absolute_time(); // Marca o início da tarefa.
-    // A variável 'cfg_temp' é global, definida em setup.c e declarada como extern em setup.h.
-    // tarefa1_obter_media_temp é bloqueante e leva aproximadamente 0.5 segundos.
-    media = tarefa1_obter_media_temp(&cfg_temp, DMA_TEMP_CHANNEL);
-    fim_tarefa1 = get_absolute_time(); // Marca o fim da tarefa.
-}
-
-void executar_tarefa_2_analise_tendencia() {
-    // Mede o tempo da tarefa de análise de tendência.
-    ini_tarefa3 = get_absolute_time();
-    t = tarefa3_analisa_tendencia(media); // Analisa a tendência com base na média da temperatura.
-    fim_tarefa3 = get_absolute_time();
-}
-
-void executar_tarefa_3_display_oled() {
-    // Mede o tempo da tarefa de exibição no OLED.
-    ini_tarefa2 = get_absolute_time();
-    tarefa2_exibir_oled(media, t); // Exibe a média e a tendência no display.
-    fim_tarefa2 = get_absolute_time();
-}
-
-void executar_tarefa_4_controle_neopixel() {
-    ini_tarefa4 = get_absolute_time();
-    tarefa4_matriz_cor_por_tendencia(t); // Controla a cor dos LEDs NeoPixel com base na tendência.
-    fim_tarefa4 = get_absolute_time();
-}
-
-void executar_tarefa_5_extra_neopixel() {
-    // Tarefa extra para controle dos NeoPixels se a temperatura for baixa.
-    // Os 'sleep_ms(100)' aqui pausam a execução de todas as outras atividades.
-    // Se esta tarefa for executada, o ciclo total será maior que 1 segundo.
-    if (media < 1.0f) { // Comparação de float com 1.0f.
-        npSetAll(COR_BRANCA); // COR_BRANCA definida em testes_cores.h
-        npWrite();
-        sleep_ms(100); // Pausa de 100ms.
-        npClear();
-        npWrite();
-        sleep_ms(100); // Pausa de 100ms.
-    }
-}
+/**
+ * ------------------------------------------------------------
+ * Arquivo: main.c
+ * Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ * Descrição:
+ * Ciclo principal do sistema embarcado, baseado em um
+ * executor cíclico com tarefas principais:
+ *
+ * Tarefa 1 - Leitura da temperatura via DMA 
+ * Tarefa 2 - Exibição da temperatura e tendência no OLED 
+ * Tarefa 3 - Análise da tendência da temperatura 
+ * Tarefa 4 - Controle NeoPixel baseado na tendência
+ *
+ * As tarefas são descritas em uma tabela estática (tabela_tarefas)
+ * com período em ticks, fase, prazo e prioridade, e executadas pelo
+ * escalonador (escalonador.c), cujo tick vem de um repeating_timer.
+ * Cada tarefa pode ter o seu próprio ritmo: a aquisição e a
+ * tendência a cada ciclo de 1 s, o OLED a 2 Hz e a matriz NeoPixel
+ * a cada 30 ms para os efeitos.
+ *
+ * A Tarefa 1 é assíncrona: uma entrada da tabela dispara a janela
+ * de aquisição e outra, guardada por tarefa1_pronta(), fecha o
+ * ciclo (média, Tarefa 5 e Tarefa 3) quando a média fica
+ * disponível; o laço permanece livre durante os 0,5 s de amostragem.
+ * Antes do disparo, a janela é limitada ao que falta até o prazo da
+ * Tarefa 3, descontado o pior fechamento medido: se o ciclo começou
+ * atrasado, a média sai com menos amostras, mas no prazo.
+ *
+ * Para a primeira leitura sair logo após o boot, a primeira janela é
+ * limitada a TAREFA1_JANELA_BOOT_US (média com menos amostras) e o
+ * OLED e a matriz só são configurados (setup_saidas) depois que ela
+ * foi disparada, enquanto o DMA enche o primeiro bloco. As etapas do
+ * boot até a primeira leitura aparecem em 's'.
+ *
+ * O watchdog é alimentado a cada ciclo fechado; sem nenhum fechamento
+ * em WATCHDOG_PRAZO_MS (laço travado), o RP2040 reinicia. Com um
+ * ciclo mais curto pelo shell, o prazo acompanha o ciclo, mas nunca
+ * fica abaixo de WATCHDOG_MINIMO_MS: o benchmark de ruído ('b')
+ * alimenta o watchdog só a cada janela, e a gravação na flash também
+ * bloqueia o laço.
+ *
+ * Com TEMPCYCLE_MULTICORE (setup.h), as Tarefas 1 e 3 rodam no
+ * núcleo 1 (nucleo1_aquisicao.c), que publica cada resultado em
+ * uma fila sem trava; no núcleo 0 a entrada de aquisição da tabela
+ * é substituída pelo consumo da fila.
+ *
+ * Os efeitos da matriz NeoPixel (LabNeoPixel/efeitos.c) não
+ * bloqueiam: a Tarefa 5 apenas inicia a piscada na camada de alerta
+ * e a Tarefa 4 avança um quadro por vez com efeitoServico(). A
+ * matriz é composta em camadas (cor da tendência, alerta, efeito) e
+ * a Tarefa 4 é a única que envia: um quadro composto e no máximo uma
+ * transferência por execução.
+ *
+ * A cada ciclo, um registro binário de telemetria (telemetria.h) é
+ * enfileirado e drenado para a USB conforme houver espaço de
+ * transmissão; com TEMPCYCLE_TELEMETRIA_TEXTO a linha de texto
+ * legível é impressa no lugar (depuração).
+ *
+ * Sem trabalho pendente o núcleo dorme em __wfi() até o próximo
+ * IRQ, e o ADC e o sensor só ficam ligados durante as janelas da
+ * Tarefa 1; o ciclo de trabalho aparece nas estatísticas.
+ *
+ * Pela USB, 's' imprime as estatísticas de execução (mín/máx/média e
+ * histograma de cada tarefa, atraso do tick e latência do DMA) e 'r'
+ * as zera (estatisticas.c).
+ *
+ * Cada ciclo também vai para o histórico na flash (historico.c), que
+ * grava uma página a cada 31 ciclos fora da janela de aquisição; 'h'
+ * o envia pela USB, com a telemetria suspensa durante o envio.
+ *
+ * Com 'c', os blocos brutos do ADC vão para a USB (captura.c), direto
+ * do ping-pong e empacotados em 12 bits; o envio roda a cada volta do
+ * laço, para acompanhar o esvaziamento do FIFO da CDC, e a telemetria
+ * também fica suspensa.
+ *
+ * Linhas de texto pela USB vão para o shell de ajustes (ajustes.c),
+ * que altera em execução o ciclo, a janela, os limiares, o I2C e os
+ * períodos do OLED e da matriz (aplicar_periodos) e grava o perfil
+ * na flash pela mesma tarefa do histórico.
+ * ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/watchdog.h"
+
+#include "setup.h"           // Para cfg_temp e setup()
+#include "tarefa1_temp.h"
+#include "tarefa2_display.h"
+#include "tarefa3_tendencia.h"
+#include "tarefa4_controla_neopixel.h"
+#include "neopixel_driver.h"
+#include "testes_cores.h"
+#include "pico/stdio_usb.h" 
+#include "fila_resultados.h"
+#include "nucleo1_aquisicao.h"
+#include "efeitos.h"
+#include "escalonador.h"
+#include "estatisticas.h"
+#include "telemetria.h"
+#include "historico.h"
+#include "ajustes.h"
+#include "captura.h"
+#include "formato.h"
+#include "calibracao.h"
+
+#define PERIODO_CICLO_MS 1000   // Período do executor cíclico (quadro maior)
+#define TICK_US          10000  // Quadro menor do escalonador
+#define TICKS_CICLO      (PERIODO_CICLO_MS * 1000 / TICK_US)
+#define TICK_MS          (TICK_US / 1000)
+#define TICKS_OLED       (TICKS_CICLO / 2)   // 2 Hz
+#define TICKS_MATRIZ     3                   // 30 ms por quadro de efeito
+#define FOLGA_FECHAMENTO_US TICK_US        // O fim da janela é percebido em até um tick
+#define WATCHDOG_CICLOS  2                  // Prazo duro: dois ciclos sem fechar
+#define WATCHDOG_PRAZO_MS (WATCHDOG_CICLOS * PERIODO_CICLO_MS)
+#define WATCHDOG_MINIMO_MS (TAREFA1_DURACAO_MAX_US / 1000 + 500)   // Maior bloqueio ('b', flash) com folga
+#define PRAZO_T3_PERMIL  900                 // Tarefa 3: 90% do ciclo
+
+// Variáveis globais para dados entre tarefas
+float media;
+tendencia_t t;
+absolute_time_t ini_tarefa1, fim_tarefa1;   // Janela assíncrona da Tarefa 1
+
+// Funções executadas pela tabela de tarefas
+void executar_tarefa_1_iniciar_leitura(void);
+void executar_tarefa_1_concluir_leitura(void);
+bool tarefa_1_concluida(void);
+#if TEMPCYCLE_MULTICORE
+void executar_tarefa_1_consumir_resultado(void);
+#endif
+void executar_tarefa_2_display_oled(void);
+void executar_tarefa_3_analise_tendencia(void);
+void executar_tarefa_4_controle_neopixel(void);
+void executar_tarefa_5_extra_neopixel(void);
+void imprimir_ciclo(int32_t media_centi, int64_t tempo1_us, int64_t tempo2_us, int64_t tempo3_us,
+                    int64_t tempo4_us, uint32_t amostras);
+void publicar_ciclo(absolute_time_t fim_t1, uint16_t media_bruta_q4, int32_t media_centi,
+                    uint32_t amostras, uint32_t tempo1_us, uint32_t tempo3_us);
+bool historico_pronto(void);
+void executar_historico(void);
+bool usb_livre(void);
+void aplicar_periodos(uint32_t ciclo_ms, uint32_t oled_ms, uint32_t matriz_ms);
+
+enum {
+#if TEMPCYCLE_MULTICORE
+    TAREFA_RESULTADO,       // Consome a fila do núcleo 1 (Tarefas 1, 3 e 5)
+#else
+    TAREFA_AQUISICAO,       // Dispara a janela da Tarefa 1
+    TAREFA_TENDENCIA,       // Fecha a Tarefa 1 e executa as Tarefas 5 e 3
+#endif
+    TAREFA_DISPLAY,
+    TAREFA_NEOPIXEL,
+    TAREFA_COMANDOS,        // Comandos de estatística pela USB
+    TAREFA_TELEMETRIA,      // Drena a fila de telemetria para a USB
+    TAREFA_HISTORICO,       // Grava o histórico, o perfil e a calibração, atende o envio pela USB
+    NUM_TAREFAS
+};
+
+// Tabela de tarefas: período e fase em ticks de TICK_US, prazo relativo à liberação.
+// O OLED usa a fase 5: roda 50 ms após o início do ciclo (e a cada meio ciclo),
+// fora do tick em que a janela é disparada. A janela ainda está em curso, e o
+// display mostra a média do ciclo anterior.
+static tarefa_escalonada_t tabela_tarefas[NUM_TAREFAS] = {
+#if TEMPCYCLE_MULTICORE
+    [TAREFA_RESULTADO] = { "T1 fila",      executar_tarefa_1_consumir_resultado, fila_resultados_disponivel,
+                           .periodo = 1,           .fase = 0, .prazo_us = 0,       .prioridade = 0 },
+#else
+    [TAREFA_AQUISICAO] = { "T1 aquisicao", executar_tarefa_1_iniciar_leitura, NULL,
+                           .periodo = TICKS_CICLO, .fase = 0, .prazo_us = TICK_US, .prioridade = 0 },
+    [TAREFA_TENDENCIA] = { "T3 tendencia", executar_tarefa_3_analise_tendencia, tarefa_1_concluida,
+                           .periodo = TICKS_CICLO, .fase = 0, .prazo_us = PERIODO_CICLO_MS * PRAZO_T3_PERMIL,
+                           .prioridade = 1 },
+#endif
+    [TAREFA_DISPLAY]   = { "T2 display",   executar_tarefa_2_display_oled, NULL,
+                           .periodo = TICKS_OLED,  .fase = 5, .prazo_us = 50000, .prioridade = 2 },
+    [TAREFA_NEOPIXEL]  = { "T4 neopixel",  executar_tarefa_4_controle_neopixel, NULL,
+                           .periodo = TICKS_MATRIZ, .fase = 0, .prazo_us = 30000,   .prioridade = 3 },
+    [TAREFA_COMANDOS]  = { "USB comandos", estatisticas_processar_comandos, NULL,
+                           .periodo = 10,          .fase = 0, .prazo_us = 0,       .prioridade = 4 },
+    [TAREFA_TELEMETRIA] = { "USB telemetria", telemetria_drenar, usb_livre,
+                           .periodo = 1,           .fase = 0, .prazo_us = 0,       .prioridade = 5 },
+    [TAREFA_HISTORICO] = { "Historico",    executar_historico, historico_pronto,
+                           .periodo = 1,           .fase = 0, .prazo_us = 0,       .prioridade = 6 },
+};
+
+int main() {
+    setup(); // Chama a função de configuração inicial do hardware e periféricos.
+
+#if TEMPCYCLE_MULTICORE
+    // O núcleo 1 cuida do ritmo da aquisição e da tendência.
+    nucleo1_iniciar(PERIODO_CICLO_MS);
+    setup_saidas();   // A primeira janela já corre no núcleo 1
+#endif
+
+    // O tick do escalonador vem de um repeating_timer; o callback só conta
+    // ticks e as tarefas rodam aqui, fora do contexto de interrupção.
+    if (!escalonador_iniciar(tabela_tarefas, NUM_TAREFAS, TICK_US)) {
+        printf("Falha ao adicionar o timer principal!\n");
+        while(1) {
+            tight_loop_contents(); // Loop de erro simples.
+        }
+    }
+
+    setup_marcar_etapa("escalonador");
+
+    // Pausa durante a depuração (breakpoints não causam reinício)
+    watchdog_enable(WATCHDOG_PRAZO_MS, true);
+
+    // Valores de compilação e, se houver, o perfil gravado pelo shell
+    ajustes_iniciar(PERIODO_CICLO_MS, TICKS_OLED * TICK_MS, TICKS_MATRIZ * TICK_MS, aplicar_periodos);
+
+    while (true) { // Loop infinito principal do programa.
+        escalonador_despachar();
+        captura_servico();        // Cada IRQ da USB abre espaço para um trecho
+        escalonador_aguardar();   // Dorme até o próximo tick ou IRQ
+    }
+
+    return 0; 
+}
+
+// Imprime os resultados e tempos no terminal serial USB. Números em ponto
+// fixo (formato.h): o printf do firmware não tem suporte a %f.
+void imprimir_ciclo(int32_t media_centi, int64_t tempo1_us, int64_t tempo2_us, int64_t tempo3_us,
+                    int64_t tempo4_us, uint32_t amostras) {
+    char temp[FORMATO_TAMANHO_MAX], t1[FORMATO_TAMANHO_MAX], t2[FORMATO_TAMANHO_MAX],
+         t3[FORMATO_TAMANHO_MAX], t4[FORMATO_TAMANHO_MAX];
+    if (media_centi == CALIBRACAO_INVALIDA) snprintf(temp, sizeof(temp), "--");
+    else formatar_fixo(temp, sizeof(temp), media_centi, 2, 2, 0, NULL);
+    formatar_fixo(t1, sizeof(t1), (int32_t)tempo1_us, 6, 3, 0, "s");
+    formatar_fixo(t2, sizeof(t2), (int32_t)tempo2_us, 6, 3, 0, "s");
+    formatar_fixo(t3, sizeof(t3), (int32_t)tempo3_us, 6, 3, 0, "s");
+    formatar_fixo(t4, sizeof(t4), (int32_t)tempo4_us, 6, 3, 0, "s");
+    printf("Temperatura: %s C | Amostras: %lu | T1(Leitura): %s | T_Disp: %s | T_Tend: %s | T_NeoP: %s | Tend: %s | Prazos perdidos: %lu\n",
+           temp,
+           (unsigned long)amostras,
+           t1, t2, t3, t4,
+           tendencia_para_texto(t),
+           (unsigned long)escalonador_prazos_perdidos());
+}
+
+// Saída do ciclo: registro binário na fila de telemetria ou, no modo de
+// depuração, a linha de texto.
+void publicar_ciclo(absolute_time_t fim_t1, uint16_t media_bruta_q4, int32_t media_centi,
+                    uint32_t amostras, uint32_t tempo1_us, uint32_t tempo3_us) {
+    uint32_t tempo2_us = tabela_tarefas[TAREFA_DISPLAY].exec_us;
+    uint32_t tempo4_us = tabela_tarefas[TAREFA_NEOPIXEL].exec_us;
+
+    static bool primeira_leitura = true;
+    if (primeira_leitura) {
+        setup_marcar_etapa("1a_leitura");
+        primeira_leitura = false;
+    }
+
+    bool valida = media_centi != CALIBRACAO_INVALIDA;
+    if (valida) historico_registrar(to_ms_since_boot(fim_t1), media_centi, (uint8_t)t);
+    watchdog_update();   // Ciclo fechado
+
+#if TEMPCYCLE_TELEMETRIA_TEXTO
+    (void)media_bruta_q4;
+    (void)valida;
+    imprimir_ciclo(media_centi, tempo1_us, tempo2_us, tempo3_us, tempo4_us, amostras);
+#else
+    (void)amostras;   // O registro binário traz a duração da janela (t1_us)
+    telemetria_registro_t r = {
+        .timestamp_us = (uint32_t)to_us_since_boot(fim_t1),
+        .media_bruta_q4 = media_bruta_q4,
+        .media_centi = valida ? (int16_t)media_centi : TELEMETRIA_CENTI_INVALIDA,
+        .tendencia = (uint8_t)t,
+        .tempo_us = { tempo1_us, tempo2_us, tempo3_us, tempo4_us },
+    };
+    telemetria_registrar(&r);
+#endif
+}
+
+// A gravação deixa a flash inacessível (~1 ms por página, ~45 ms ao apagar
+// um setor) e estaciona o outro núcleo; ela fica fora da janela da Tarefa 1
+// para o ping-pong não perder blocos. No modo de dois núcleos, só com o
+// núcleo 1 dormindo entre janelas, e a reserva segura a janela seguinte
+// até a gravação terminar.
+static bool flash_livre(void) {
+#if TEMPCYCLE_MULTICORE
+    return nucleo1_entre_janelas();
+#else
+    return !tarefa1_em_andamento();
+#endif
+}
+
+static bool reservar_flash(void) {
+#if TEMPCYCLE_MULTICORE
+    return nucleo1_reservar_flash();
+#else
+    return flash_livre();
+#endif
+}
+
+static void liberar_flash(void) {
+#if TEMPCYCLE_MULTICORE
+    nucleo1_liberar_flash();
+#endif
+}
+
+static bool historico_pode_gravar(void) {
+    return historico_gravacao_pendente() && flash_livre();
+}
+
+static bool ajustes_podem_gravar(void) {
+    return ajustes_gravacao_pendente() && flash_livre();
+}
+
+static bool calibracao_pode_gravar(void) {
+    return calibracao_gravacao_pendente() && flash_livre();
+}
+
+bool historico_pronto(void) {
+    return historico_pode_gravar() || ajustes_podem_gravar() || calibracao_pode_gravar() ||
+           historico_exportando();
+}
+
+// Uma operação de flash por liberação: o histórico primeiro, depois o perfil e a calibração
+void executar_historico(void) {
+    if ((historico_pode_gravar() || ajustes_podem_gravar() || calibracao_pode_gravar()) &&
+        reservar_flash()) {
+        if (historico_gravacao_pendente()) historico_gravar();
+        else if (ajustes_gravacao_pendente()) ajustes_gravar();
+        else calibracao_gravar();
+        liberar_flash();
+    }
+    historico_exportar_servico();
+}
+
+// O envio do histórico e a captura usam a USB sozinhos para as páginas e
+// os trechos não se intercalarem com registros de telemetria.
+bool usb_livre(void) {
+    return !historico_exportando() && !captura_ativa();
+}
+
+// Períodos vindos do shell de ajustes, já em múltiplos de TICK_MS.
+void aplicar_periodos(uint32_t ciclo_ms, uint32_t oled_ms, uint32_t matriz_ms) {
+#if TEMPCYCLE_MULTICORE
+    nucleo1_definir_periodo(ciclo_ms);
+#else
+    tabela_tarefas[TAREFA_AQUISICAO].periodo = (uint16_t)(ciclo_ms / TICK_MS);
+    tabela_tarefas[TAREFA_TENDENCIA].periodo = (uint16_t)(ciclo_ms / TICK_MS);
+    tabela_tarefas[TAREFA_TENDENCIA].prazo_us = ciclo_ms * PRAZO_T3_PERMIL;
+#endif
+    uint16_t oled = (uint16_t)(oled_ms / TICK_MS);
+    tabela_tarefas[TAREFA_DISPLAY].periodo = oled;
+    tabela_tarefas[TAREFA_DISPLAY].fase = oled > 5 ? 5 : oled - 1;   // 50 ms após o início do ciclo; período curto: último tick
+    tabela_tarefas[TAREFA_NEOPIXEL].periodo = (uint16_t)(matriz_ms / TICK_MS);
+
+    uint32_t prazo_ms = WATCHDOG_CICLOS * ciclo_ms;
+    watchdog_enable(prazo_ms > WATCHDOG_MINIMO_MS ? prazo_ms : WATCHDOG_MINIMO_MS, true);
+}
+
+void executar_tarefa_1_iniciar_leitura() {
+    ini_tarefa1 = get_absolute_time(); // Marca o início da tarefa.
+
+#if !TEMPCYCLE_MULTICORE
+    static bool primeira_janela = true;
+
+    // Orçamento: até o prazo da Tarefa 3, menos o seu pior tempo de execução
+    const tarefa_escalonada_t *t3 = &tabela_tarefas[TAREFA_TENDENCIA];
+    int64_t orcamento = escalonador_folga_us(t3) - t3->exec.max_us - FOLGA_FECHAMENTO_US;
+    if (primeira_janela && orcamento > TAREFA1_JANELA_BOOT_US) orcamento = TAREFA1_JANELA_BOOT_US;
+    tarefa1_definir_orcamento(orcamento > 0 ? (uint32_t)orcamento : 0);
+#endif
+
+    // As variáveis 'cfg_temp' e 'cfg_temp_b' são globais, definidas em setup.c e declaradas como extern em setup.h.
+    // tarefa1_iniciar retorna imediatamente; a janela dura aproximadamente 0.5 segundos.
+    tarefa1_iniciar(&cfg_temp, DMA_TEMP_CHANNEL, &cfg_temp_b, DMA_TEMP_CHANNEL_B);
+
+#if !TEMPCYCLE_MULTICORE
+    // OLED e matriz configurados com o primeiro bloco já em captura; as
+    // Tarefas 2 e 4 deste tick rodam depois desta (prioridade menor)
+    if (primeira_janela) {
+        setup_saidas();
+        primeira_janela = false;
+    }
+#endif
+}
+
+// Guarda da tarefa de tendência: a janela da Tarefa 1 terminou.
+bool tarefa_1_concluida() {
+    return tarefa1_em_andamento() && tarefa1_pronta();
+}
+
+void executar_tarefa_1_concluir_leitura() {
+    // Sem leitura no ciclo: display e Tarefa 5 continuam com a última média
+    int32_t centi = tarefa1_resultado()->media_centi;
+    if (centi != CALIBRACAO_INVALIDA) media = centi / 100.0f;
+    fim_tarefa1 = get_absolute_time(); // Marca o fim da tarefa.
+}
+
+// Fecha o ciclo de 1 s: média da Tarefa 1, Tarefa 5 e análise da tendência.
+void executar_tarefa_3_analise_tendencia() {
+    executar_tarefa_1_concluir_leitura();
+    executar_tarefa_5_extra_neopixel();
+
+    absolute_time_t ini = get_absolute_time();
+    // Canal principal no próprio estado, como os demais canais do round-robin
+    const tarefa1_resultado_t *leitura = tarefa1_resultado();
+    const tarefa3_resultado_t *analise = tarefa3_atualizar_canal(leitura->canal_principal, leitura->media_centi);
+    t = analise->tendencia;
+    tarefa3_atualizar_canais(leitura->centi_canal,
+                             leitura->canais & ~(1u << leitura->canal_principal));
+    int64_t tempo3_us = absolute_time_diff_us(ini, get_absolute_time());
+
+    // Coluna nova do gráfico do OLED, na escala da janela da Tarefa 3
+    if (leitura->media_centi != CALIBRACAO_INVALIDA) {
+        tarefa2_registrar_leitura(leitura->media_centi, analise->minimo_centi, analise->maximo_centi);
+    }
+
+    publicar_ciclo(fim_tarefa1, leitura->media_bruta_q4, leitura->media_centi, leitura->amostras,
+                   (uint32_t)absolute_time_diff_us(ini_tarefa1, fim_tarefa1), (uint32_t)tempo3_us);
+}
+
+#if TEMPCYCLE_MULTICORE
+// Consome um resultado publicado pelo núcleo 1 (Tarefas 1 e 3 já feitas).
+void executar_tarefa_1_consumir_resultado() {
+    resultado_ciclo_t r;
+    if (!fila_resultados_consumir(&r)) return;
+
+    t = r.tendencia;
+    if (r.media_centi != CALIBRACAO_INVALIDA) {
+        media = r.media_centi / 100.0f;
+        tarefa2_registrar_leitura(r.media_centi, r.minimo_centi, r.maximo_centi);
+    }
+    executar_tarefa_5_extra_neopixel();
+
+    publicar_ciclo(from_us_since_boot(r.timestamp_us), r.media_bruta_q4, r.media_centi, r.amostras,
+                   r.tempo_t1_us, r.tempo_t3_us);
+}
+#endif
+
+void executar_tarefa_2_display_oled() {
+    tarefa2_exibir_oled(media, t); // Exibe a média e a tendência no display.
+}
+
+void executar_tarefa_4_controle_neopixel() {
+    // Avança os efeitos em curso; enquanto existirem, as camadas deles
+    // cobrem a cor da tendência na composição.
+    efeitoServico();
+    tarefa4_matriz_cor_por_tendencia(t); // Camada base e envio do quadro composto.
+}
+
+void executar_tarefa_5_extra_neopixel() {
+    // Tarefa extra para controle dos NeoPixels se a temperatura for baixa.
+    // Apenas inicia uma piscada (100 ms acesa, 100 ms apagada); os quadros
+    // são avançados pela Tarefa 4, sem pausar as outras tarefas.
+    if (media < 1.0f) { // Comparação de float com 1.0f.
+        efeitoIniciarNaCamada(NP_CAMADA_ALERTA, quadroPiscar, COR_BRANCA, 100); // COR_BRANCA definida em testes_cores.h
+    }
+}
@@ -0,0 +1,49 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: mapa_flash.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Regiões de dados no fim da flash, de cima para baixo:
+ *
+ *        último setor        calibração (calibracao.h)
+ *        HISTORICO_SETORES   histórico em círculo (historico.h)
+ *        1 setor             perfil do shell de ajustes (ajustes.h)
+ *
+ *      Cada região é definida a partir da anterior, então mudar
+ *      o tamanho de uma desloca as de baixo sem sobreposição. A
+ *      imagem do firmware precisa terminar abaixo da região para
+ *      que ela seja usada (mapa_flash_livre).
+ *
+ *      Toda gravação roda por flash_safe_execute() com o mesmo
+ *      prazo para estacionar o outro núcleo.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef MAPA_FLASH_H
+#define MAPA_FLASH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hardware/flash.h"
+
+#define MAPA_FLASH_TIMEOUT_MS 10   // Espera máxima para estacionar o outro núcleo
+
+#define HISTORICO_SETORES       16   // 64 KB: ~2 h de ciclos de 1 s
+#define CALIBRACAO_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+#define HISTORICO_FLASH_OFFSET  (CALIBRACAO_FLASH_OFFSET - HISTORICO_SETORES * FLASH_SECTOR_SIZE)
+#define AJUSTES_FLASH_OFFSET    (HISTORICO_FLASH_OFFSET - FLASH_SECTOR_SIZE)
+
+extern char __flash_binary_end;    // Fim da imagem do firmware (linker script)
+
+/**
+ * @brief Indica se a imagem do firmware termina antes de 'offset'.
+ */
+static inline bool mapa_flash_livre(uint32_t offset) {
+    return (uintptr_t)&__flash_binary_end - XIP_BASE <= offset;
+}
+
+#endif  // MAPA_FLASH_H
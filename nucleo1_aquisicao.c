@@ -0,0 +1,153 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: nucleo1_aquisicao.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Laço do núcleo 1 no modo de dois núcleos. A cada
+ *      período, dispara uma janela da Tarefa 1, dorme entre
+ *      os blocos do DMA, calcula a tendência (Tarefa 3) e
+ *      publica {média, tendência, instante} para o núcleo 0.
+ *
+ *      Como as escritas lentas no OLED e na matriz NeoPixel
+ *      ficam no núcleo 0, elas não atrasam mais a aquisição
+ *      nem fazem o ping-pong perder blocos.
+ *
+ *      Gravações na flash pelo núcleo 0 estacionam este núcleo
+ *      com as interrupções desligadas; elas só são liberadas
+ *      enquanto ele dorme entre janelas, e a janela seguinte
+ *      espera a gravação reservada terminar.
+ *
+ *  Relacionamento:
+ *      - Lançado por 'main.c' com nucleo1_iniciar().
+ *      - Usa 'cfg_temp'/'cfg_temp_b' de 'setup.c'.
+ *      - Publica em 'fila_resultados.c'.
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "pico/flash.h"
+#include "pico/critical_section.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "setup.h"
+#include "dma_servico.h"
+#include "tarefa1_temp.h"
+#include "tarefa3_tendencia.h"
+#include "fila_resultados.h"
+#include "nucleo1_aquisicao.h"
+
+#define FOLGA_FECHAMENTO_US 10000   // Tarefa 3 e publicação (folga ampla)
+#define NUCLEO1_ALARMES     4       // Alarmes simultâneos no pool do núcleo 1
+
+static volatile uint32_t periodo_ciclo_ms;   // Trocado pelo núcleo 0 (shell de ajustes)
+
+static critical_section_t trava_flash;      // Protege as duas flags abaixo entre os núcleos
+static volatile bool entre_janelas;         // Núcleo 1 dormindo até o próximo ciclo
+static bool flash_reservada;                // Núcleo 0 gravando: a próxima janela espera
+
+static void marcar_entre_janelas(void) {
+    critical_section_enter_blocking(&trava_flash);
+    entre_janelas = true;
+    critical_section_exit(&trava_flash);
+}
+
+// Sai do intervalo entre janelas; com uma gravação reservada, espera por
+// ela (o tempo sai do orçamento da janela).
+static void fechar_entre_janelas(void) {
+    while (true) {
+        critical_section_enter_blocking(&trava_flash);
+        bool reservada = flash_reservada;
+        if (!reservada) entre_janelas = false;
+        critical_section_exit(&trava_flash);
+        if (!reservada) return;
+        tight_loop_contents();
+    }
+}
+
+static void nucleo1_principal(void) {
+    // Permite ao núcleo 0 estacionar este núcleo durante gravações na flash
+    flash_safe_execute_core_init();
+
+    // O handler é compartilhado; apenas a habilitação no NVIC é por núcleo
+    dma_servico_habilitar_linha(DMA_SERVICO_LINHA_AQUISICAO);
+
+    // Alarmes da Tarefa 1 atendidos aqui: o pool padrão roda no núcleo 0,
+    // que pode estar com as interrupções desligadas numa gravação na flash
+    tarefa1_usar_alarmes(alarm_pool_create_with_unused_hardware_alarm(NUCLEO1_ALARMES));
+
+    absolute_time_t proximo = get_absolute_time();
+    bool primeira_janela = true;
+
+    while (true) {
+        marcar_entre_janelas();
+        sleep_until(proximo);
+        fechar_entre_janelas();
+        proximo = delayed_by_ms(proximo, periodo_ciclo_ms);
+
+        absolute_time_t ini_t1 = get_absolute_time();
+
+        // A janela termina a tempo de a Tarefa 3 fechar antes do próximo ciclo
+        int64_t orcamento = absolute_time_diff_us(ini_t1, proximo) - FOLGA_FECHAMENTO_US;
+        if (primeira_janela && orcamento > TAREFA1_JANELA_BOOT_US) orcamento = TAREFA1_JANELA_BOOT_US;
+        primeira_janela = false;
+        tarefa1_definir_orcamento(orcamento > 0 ? (uint32_t)orcamento : 0);
+        tarefa1_iniciar(&cfg_temp, DMA_TEMP_CHANNEL, &cfg_temp_b, DMA_TEMP_CHANNEL_B);
+        while (!tarefa1_pronta()) tarefa1_aguardar();
+        absolute_time_t fim_t1 = get_absolute_time();
+
+        const tarefa1_resultado_t *leitura = tarefa1_resultado();
+        // Canal principal no próprio estado, como os demais canais do round-robin
+        const tarefa3_resultado_t *analise = tarefa3_atualizar_canal(leitura->canal_principal,
+                                                                     leitura->media_centi);
+        tendencia_t tendencia = analise->tendencia;
+        tarefa3_atualizar_canais(leitura->centi_canal,
+                                 leitura->canais & ~(1u << leitura->canal_principal));
+        absolute_time_t fim_t3 = get_absolute_time();
+
+        resultado_ciclo_t r = {
+            .media_centi = leitura->media_centi,
+            .tendencia = tendencia,
+            .minimo_centi = analise->minimo_centi,
+            .maximo_centi = analise->maximo_centi,
+            .timestamp_us = to_us_since_boot(fim_t1),
+            .amostras = leitura->amostras,
+            .media_bruta_q4 = leitura->media_bruta_q4,
+            .tempo_t1_us = (uint32_t)absolute_time_diff_us(ini_t1, fim_t1),
+            .tempo_t3_us = (uint32_t)absolute_time_diff_us(fim_t1, fim_t3),
+        };
+        fila_resultados_publicar(&r);
+    }
+}
+
+void nucleo1_iniciar(uint32_t periodo_ms) {
+    periodo_ciclo_ms = periodo_ms;
+    critical_section_init(&trava_flash);
+    multicore_launch_core1(nucleo1_principal);
+}
+
+void nucleo1_definir_periodo(uint32_t periodo_ms) {
+    periodo_ciclo_ms = periodo_ms;
+}
+
+bool nucleo1_entre_janelas(void) {
+    return entre_janelas;
+}
+
+bool nucleo1_reservar_flash(void) {
+    critical_section_enter_blocking(&trava_flash);
+    bool livre = entre_janelas;
+    if (livre) flash_reservada = true;
+    critical_section_exit(&trava_flash);
+    return livre;
+}
+
+void nucleo1_liberar_flash(void) {
+    critical_section_enter_blocking(&trava_flash);
+    flash_reservada = false;
+    critical_section_exit(&trava_flash);
+}
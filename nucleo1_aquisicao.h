@@ -0,0 +1,62 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: nucleo1_aquisicao.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Interface do modo de dois núcleos (TEMPCYCLE_MULTICORE):
+ *      o núcleo 1 executa a Tarefa 1 (aquisição) e a Tarefa 3
+ *      (tendência) no seu próprio ritmo e publica cada
+ *      resultado em 'fila_resultados'.
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef NUCLEO1_AQUISICAO_H
+#define NUCLEO1_AQUISICAO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Lança o laço de aquisição e análise no núcleo 1.
+ *
+ * Deve ser chamada após setup(). A interrupção do DMA passa a ser
+ * atendida pelo núcleo 1.
+ *
+ * @param periodo_ms Período do ciclo de aquisição.
+ */
+void nucleo1_iniciar(uint32_t periodo_ms);
+
+/**
+ * @brief Troca o período do ciclo; vale a partir do próximo ciclo.
+ */
+void nucleo1_definir_periodo(uint32_t periodo_ms);
+
+/**
+ * @brief Indica se o núcleo 1 está dormindo entre duas janelas.
+ *
+ * Só uma consulta: a janela pode começar logo depois. Para gravar na
+ * flash, use nucleo1_reservar_flash().
+ */
+bool nucleo1_entre_janelas(void);
+
+/**
+ * @brief Reserva o intervalo entre janelas para uma gravação na flash.
+ *
+ * Com a reserva feita, a próxima janela só começa depois de
+ * nucleo1_liberar_flash(); o núcleo 1 continua podendo ser estacionado
+ * por flash_safe_execute() enquanto espera.
+ *
+ * @return false se uma janela estiver em andamento; nada é reservado.
+ */
+bool nucleo1_reservar_flash(void);
+
+/**
+ * @brief Libera a reserva feita por nucleo1_reservar_flash().
+ */
+void nucleo1_liberar_flash(void);
+
+#endif  // NUCLEO1_AQUISICAO_H
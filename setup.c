@@ -1,99 +1,226 @@
-/**
- * ------------------------------------------------------------
- *  Arquivo: setup.c
- *  Projeto: TempCycleDMA
- * ------------------------------------------------------------
- *  Descrição:
- *      Este módulo centraliza todas as configurações iniciais
- *      necessárias para o funcionamento do projeto, incluindo:
- *      
- *      - Inicialização do terminal USB (stdio)
- *      - Configuração do ADC e habilitação do sensor interno
- *      - Configuração do canal DMA para leitura da temperatura
- *      - Registro da interrupção do canal DMA 0
- *      - Inicialização do display OLED (SSD1306)
- *
- *      A função principal `setup()` deve ser chamada uma única
- *      vez no início do programa, geralmente logo no `main()`,
- *      para garantir que o sistema esteja corretamente preparado
- *      antes de iniciar o executor cíclico.
- *
- *  Relacionamento:
- *      - Define a configuração global `cfg_temp` para uso
- *        posterior na Tarefa 1 (tarefa1_temp.c)
- *      - Define os símbolos globais `ssd[]` e `area` usados na
- *        Tarefa 2 (tarefa2_display.c)
- *      - Utiliza o handler de interrupção definido em
- *        'irq_handlers.c'
- *
- *  
- *  *  Data: 11/05/2025
- * ------------------------------------------------------------
- */
-
-#include "pico/stdlib.h"
-#include "hardware/adc.h"
-#include "hardware/dma.h"
-#include "hardware/irq.h"
-#include "setup.h"
-#include "irq_handlers.h"
-#include "ssd1306.h"
-#include "ssd1306_i2c.h"
-#include "hardware/i2c.h"
-#include "pico/binary_info.h"
-#include "neopixel_driver.h"
-
-// === Buffer de vídeo do OLED (tela de 128 x 64) ===
-uint8_t ssd[ssd1306_buffer_length];
-
-// === Área de renderização usada por render_on_display() ===
-struct render_area area = {
-    .start_column = 0,
-    .end_column = ssd1306_width - 1,
-    .start_page = 0,
-    .end_page = ssd1306_n_pages - 1
-};
-
-// === Configuração global do canal DMA 0 ===
-dma_channel_config cfg_temp;
-
-/**
- * @brief Realiza a configuração inicial do sistema.
- *
- * Esta função inicializa o terminal USB, ADC, sensor de temperatura,
- * canal DMA 0, interrupções e o display OLED.
- */
-void setup() {
-    // Inicializa a comunicação USB para printf()
-    stdio_init_all();
-    //while (!stdio_usb_connected()) sleep_ms(200);  // Aguarda conexão USB
-
-    // Inicializa o ADC do RP2040 e habilita o sensor interno (canal 4)
-    adc_init();
-    adc_set_temp_sensor_enabled(true);
-
-    // Configura o canal DMA 0 para transferir dados do ADC
-    cfg_temp = dma_channel_get_default_config(DMA_TEMP_CHANNEL);
-    channel_config_set_transfer_data_size(&cfg_temp, DMA_SIZE_16);  // 16 bits
-    channel_config_set_read_increment(&cfg_temp, false);            // ADC FIFO fixo
-    channel_config_set_write_increment(&cfg_temp, true);            // Buffer se move
-    channel_config_set_dreq(&cfg_temp, DREQ_ADC);                   // dispara com ADC
-
-    // Configura interrupção do canal DMA 0
-    dma_channel_set_irq0_enabled(DMA_TEMP_CHANNEL, true);
-    irq_set_exclusive_handler(DMA_IRQ_0, dma_handler_temp);
-    irq_set_enabled(DMA_IRQ_0, true);
-
-    // Inicializa o display OLED SSD1306 via I2C
-    i2c_init(i2c1, 400 * 1000);  // <---I2C primeiro
-    gpio_set_function(14, GPIO_FUNC_I2C);
-    gpio_set_function(15, GPIO_FUNC_I2C);
-    gpio_pull_up(14);
-    gpio_pull_up(15);
-
-    ssd1306_init();             // <---Depois do I2C estar pronto
-    calculate_render_area_buffer_length(&area);
-
-    // Inicializa NeoPixel (Matriz RGB)
-    npInit(LED_PIN);  // substitua LED_PIN pelo valor real, ex: 7
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: setup.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Este módulo centraliza todas as configurações iniciais
+ *      necessárias para o funcionamento do projeto, incluindo:
+ *      
+ *      - Inicialização do terminal USB (stdio)
+ *      - Configuração do ADC e habilitação do sensor interno
+ *      - Leitura da calibração do sensor gravada na flash
+ *      - Reserva e configuração dos dois canais DMA (ping-pong)
+ *        para leitura da temperatura, pelo serviço de DMA
+ *      - Registro dos callbacks de conclusão desses canais
+ *      - Barramento I2C do display OLED (SSD1306)
+ *
+ *      A função principal `setup()` deve ser chamada uma única
+ *      vez no início do programa, geralmente logo no `main()`,
+ *      para garantir que o sistema esteja corretamente preparado
+ *      antes de iniciar o executor cíclico.
+ *
+ *      O display e a matriz NeoPixel são configurados à parte,
+ *      por `setup_saidas()`, que o main.c chama logo depois de
+ *      disparar a primeira janela de aquisição: o envio da
+ *      lista de inicialização do OLED e a carga do programa da
+ *      PIO correm enquanto o DMA já enche o primeiro bloco.
+ *
+ *      Cada etapa do boot é marcada com o instante desde o
+ *      reset (setup_marcar_etapa); 's' imprime a sequência.
+ *
+ *  Relacionamento:
+ *      - Define as configurações globais `cfg_temp` e `cfg_temp_b`
+ *        para uso posterior na Tarefa 1 (tarefa1_temp.c)
+ *      - Define os símbolos globais `ssd[]` e `area` usados na
+ *        Tarefa 2 (tarefa2_display.c)
+ *      - Registra no serviço de DMA ('dma_servico.c') o
+ *        callback definido em 'irq_handlers.c'
+ *
+ *  
+ *  *  Data: 11/05/2025
+ * ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "setup.h"
+#include "irq_handlers.h"
+#include "dma_servico.h"
+#include "ssd1306.h"
+#include "ssd1306_i2c.h"
+#include "hardware/i2c.h"
+#include "pico/binary_info.h"
+#include "neopixel_driver.h"
+#include "calibracao.h"
+#include "historico.h"
+
+#define BOOT_ETAPAS_MAX 12
+
+typedef struct {
+    const char *nome;
+    uint32_t instante_us;   // Desde o reset
+} etapa_boot_t;
+
+static etapa_boot_t etapas[BOOT_ETAPAS_MAX];
+static uint32_t num_etapas = 0;
+
+// === Buffer de vídeo do OLED (tela de 128 x 64) ===
+// A primeira posição fica reservada para o byte de controle 0x40 do I2C,
+// de modo que o quadro é enviado direto do buffer, sem malloc nem cópia.
+static uint8_t ssd_com_controle[1 + ssd1306_buffer_length];
+uint8_t *const ssd = ssd_com_controle + 1;
+
+// === Área de renderização usada por render_on_display() ===
+struct render_area area = {
+    .start_column = 0,
+    .end_column = ssd1306_width - 1,
+    .start_page = 0,
+    .end_page = ssd1306_n_pages - 1
+};
+
+// === Canais e configuração global do ping-pong do ADC ===
+uint dma_temp_canais[2];
+dma_channel_config cfg_temp;
+dma_channel_config cfg_temp_b;
+
+/**
+ * @brief Monta a configuração de um canal do ping-pong do ADC.
+ *
+ * Os dois canais são idênticos, exceto pelo encadeamento: ao terminar
+ * seu bloco, cada um dispara o outro, de modo que o ADC nunca fica
+ * sem destino entre blocos.
+ *
+ * @param canal Canal a configurar.
+ * @param encadear_com Canal disparado ao final do bloco.
+ */
+static dma_channel_config configurar_canal_temp(uint canal, uint encadear_com) {
+    dma_channel_config cfg = dma_channel_get_default_config(canal);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);  // 16 bits
+    channel_config_set_read_increment(&cfg, false);            // ADC FIFO fixo
+    channel_config_set_write_increment(&cfg, true);            // Buffer se move
+    channel_config_set_dreq(&cfg, DREQ_ADC);                   // dispara com ADC
+    channel_config_set_chain_to(&cfg, encadear_com);           // ping-pong
+    return cfg;
+}
+
+/**
+ * @brief Monta a configuração do canal observado pelo sniffer.
+ *
+ * Todas as amostras são escritas sobre uma mesma palavra descartável
+ * (sem incremento de escrita); quem guarda a soma é o sniffer. As
+ * transferências são de 32 bits para que o sniffer some exatamente o
+ * valor lido do FIFO, sem a replicação de meia-palavra no barramento.
+ *
+ * @param canal Canal a configurar.
+ */
+static dma_channel_config configurar_canal_sniffer(uint canal) {
+    dma_channel_config cfg = dma_channel_get_default_config(canal);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_32);  // palavra do FIFO
+    channel_config_set_read_increment(&cfg, false);            // ADC FIFO fixo
+    channel_config_set_write_increment(&cfg, false);           // destino fixo
+    channel_config_set_dreq(&cfg, DREQ_ADC);                   // dispara com ADC
+    channel_config_set_sniff_enable(&cfg, true);               // soma no sniffer
+    return cfg;
+}
+
+void setup_marcar_etapa(const char *nome) {
+    if (num_etapas >= BOOT_ETAPAS_MAX) return;
+    etapas[num_etapas].nome = nome;
+    etapas[num_etapas].instante_us = time_us_32();
+    num_etapas++;
+}
+
+void setup_imprimir_boot(void) {
+    printf("boot (us desde o reset):");
+    for (uint32_t i = 0; i < num_etapas; i++) {
+        printf(" %s=%lu", etapas[i].nome, (unsigned long)etapas[i].instante_us);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Realiza a configuração inicial do sistema.
+ *
+ * Esta função inicializa o terminal USB, ADC, sensor de temperatura,
+ * canais DMA do ADC, interrupções e o barramento I2C do OLED.
+ */
+void setup() {
+    setup_marcar_etapa("inicio");
+#if TEMPCYCLE_SYS_CLOCK_KHZ
+    // Antes de qualquer periférico: I2C, PIO e UART calculam seus
+    // divisores a partir de clk_sys na inicialização
+    set_sys_clock_khz(TEMPCYCLE_SYS_CLOCK_KHZ, true);
+    setup_marcar_etapa("clock");
+#endif
+
+    // Inicializa a comunicação USB para printf()
+    stdio_init_all();
+    //while (!stdio_usb_connected()) sleep_ms(200);  // Aguarda conexão USB
+    setup_marcar_etapa("usb");
+
+    // Inicializa o ADC do RP2040; ele e o sensor interno (canal 4) ficam
+    // desligados e só são ligados pela Tarefa 1 durante cada janela
+    adc_init();
+    hw_clear_bits(&adc_hw->cs, ADC_CS_EN_BITS);
+    calibracao_carregar();
+    historico_iniciar();
+    setup_marcar_etapa("flash");
+
+#if TAREFA1_USAR_SNIFFER
+    // Canal do ADC, com a soma feita pelo sniffer
+    dma_temp_canais[0] = dma_servico_reservar("adc", DMA_SERVICO_LINHA_AQUISICAO,
+                                              dma_temp_bloco_concluido, NULL);
+    dma_temp_canais[1] = dma_temp_canais[0];
+    cfg_temp = configurar_canal_sniffer(DMA_TEMP_CHANNEL);
+#else
+    // Dois canais para o ADC, encadeados entre si; o contexto é a metade
+    dma_temp_canais[0] = dma_servico_reservar("adc_a", DMA_SERVICO_LINHA_AQUISICAO,
+                                              dma_temp_bloco_concluido, (void *)0);
+    dma_temp_canais[1] = dma_servico_reservar("adc_b", DMA_SERVICO_LINHA_AQUISICAO,
+                                              dma_temp_bloco_concluido, (void *)1);
+    cfg_temp = configurar_canal_temp(DMA_TEMP_CHANNEL, DMA_TEMP_CHANNEL_B);
+    cfg_temp_b = configurar_canal_temp(DMA_TEMP_CHANNEL_B, DMA_TEMP_CHANNEL);
+#endif
+#if !TEMPCYCLE_MULTICORE
+    // No modo multicore, habilitada pelo núcleo 1
+    dma_servico_habilitar_linha(DMA_SERVICO_LINHA_AQUISICAO);
+#endif
+    setup_marcar_etapa("dma");
+
+    // Barramento do display OLED SSD1306; o painel fica para setup_saidas()
+    i2c_init(i2c1, ssd1306_i2c_clock * 1000);  // <---I2C primeiro
+    gpio_set_function(14, GPIO_FUNC_I2C);
+    gpio_set_function(15, GPIO_FUNC_I2C);
+    gpio_pull_up(14);
+    gpio_pull_up(15);
+    setup_marcar_etapa("setup");
+}
+
+/**
+ * @brief Configura o display OLED e a matriz NeoPixel.
+ *
+ * Chamada uma vez, depois de setup() e antes da primeira execução das
+ * Tarefas 2 e 4; a lista de inicialização do painel vai em uma única
+ * transação I2C.
+ */
+void setup_saidas(void) {
+    ssd1306_init();             // <---Depois do I2C estar pronto
+    ssd1306_async_init();       // Canal DMA para o envio não bloqueante
+    calculate_render_area_buffer_length(&area);
+    setup_marcar_etapa("oled");
+
+    // Inicializa NeoPixel (Matriz RGB): uma fita por pino de NP_PINOS
+    static const uint pinos_matriz[] = { NP_PINOS };
+    _Static_assert(sizeof(pinos_matriz) / sizeof(pinos_matriz[0]) == NP_FITAS,
+                   "NP_PINOS deve listar exatamente NP_FITAS pinos");
+    npInitFitas(pinos_matriz, NP_FITAS);
+
+    // Conclusões do OLED e da matriz, atendidas pelo núcleo 0
+    dma_servico_habilitar_linha(DMA_SERVICO_LINHA_SAIDA);
+    setup_marcar_etapa("neopixel");
 }
\ No newline at end of file
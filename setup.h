@@ -1,12 +1,57 @@
-#ifndef SETUP_H
-#define SETUP_H
-
-#include "hardware/dma.h"
-
-#define DMA_TEMP_CHANNEL 0
-
-extern dma_channel_config cfg_temp;
-
-void setup(void);
-
-#endif
+#ifndef SETUP_H
+#define SETUP_H
+
+#include "hardware/dma.h"
+
+// Modo de aquisição da Tarefa 1:
+//   0 → ping-pong em buffer, média somada pela CPU
+//   1 → soma feita pelo sniffer do DMA, sem buffer de amostras
+#ifndef TAREFA1_USAR_SNIFFER
+#define TAREFA1_USAR_SNIFFER 0
+#endif
+
+// Modo de execução:
+//   0 → todas as tarefas no núcleo 0, em sequência
+//   1 → Tarefas 1 e 3 no núcleo 1, Tarefas 2 e 4 no núcleo 0
+#ifndef TEMPCYCLE_MULTICORE
+#define TEMPCYCLE_MULTICORE 0
+#endif
+
+// Clock do sistema em kHz (0 → padrão do SDK, 125 MHz). Um valor menor
+// reduz o consumo; ADC e USB usam o PLL_USB e não são afetados.
+#ifndef TEMPCYCLE_SYS_CLOCK_KHZ
+#define TEMPCYCLE_SYS_CLOCK_KHZ 0
+#endif
+
+// Saída de cada ciclo pela USB:
+//   0 → registros binários de telemetria (tools/decodificar_telemetria.py)
+//   1 → linha de texto legível (depuração)
+#ifndef TEMPCYCLE_TELEMETRIA_TEXTO
+#define TEMPCYCLE_TELEMETRIA_TEXTO 0
+#endif
+
+// Canais do ADC, reservados em setup() pelo serviço de DMA (dma_servico.h)
+extern uint dma_temp_canais[2];
+#define DMA_TEMP_CHANNEL   (dma_temp_canais[0])   // Metade A do ping-pong do ADC (ou canal do sniffer)
+#define DMA_TEMP_CHANNEL_B (dma_temp_canais[1])   // Metade B, encadeada ao canal A (= A com sniffer)
+
+extern dma_channel_config cfg_temp;
+extern dma_channel_config cfg_temp_b;
+
+void setup(void);
+void setup_saidas(void);
+
+/**
+ * @brief Registra o instante (desde o reset) em que uma etapa do boot terminou.
+ *
+ * Até 12 etapas por boot; as seguintes são ignoradas. 'nome' deve
+ * ser uma string estática.
+ */
+void setup_marcar_etapa(const char *nome);
+
+/**
+ * @brief Imprime as etapas do boot marcadas.
+ */
+void setup_imprimir_boot(void);
+
+#endif
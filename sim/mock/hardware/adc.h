@@ -0,0 +1,15 @@
+// SDK simulado: ADC alimentado por um fluxo sintético (sim_adc_definir_fonte).
+#ifndef SIM_HARDWARE_ADC_H
+#define SIM_HARDWARE_ADC_H
+
+#include "pico/stdlib.h"
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint entrada);
+uint adc_get_selected_input(void);
+void adc_set_temp_sensor_enabled(bool ativo);
+void adc_set_round_robin(uint mascara);
+uint16_t adc_read(void);
+
+#endif
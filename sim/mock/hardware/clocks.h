@@ -0,0 +1,13 @@
+// SDK simulado: clocks nominais.
+#ifndef SIM_HARDWARE_CLOCKS_H
+#define SIM_HARDWARE_CLOCKS_H
+
+#include "pico/stdlib.h"
+
+enum clock_index { clk_gpout0, clk_ref, clk_sys, clk_peri, clk_usb, clk_adc };
+
+static inline uint32_t clock_get_hz(enum clock_index clk) {
+    return clk == clk_adc || clk == clk_usb ? 48000000u : 125000000u;
+}
+
+#endif
@@ -0,0 +1,40 @@
+// SDK simulado: DMA que executa a transferência inteira no disparo.
+// Escritas em IC_DATA_CMD do i2c1 e no FIFO de TX da PIO são entregues
+// aos periféricos simulados (sdk_simulado.c); as demais vão à memória.
+#ifndef SIM_HARDWARE_DMA_H
+#define SIM_HARDWARE_DMA_H
+
+#include "pico/stdlib.h"
+
+#define NUM_DMA_CHANNELS 12
+
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+
+typedef struct {
+    enum dma_channel_transfer_size tamanho;
+    bool incrementa_leitura;
+    bool incrementa_escrita;
+    uint dreq;
+} dma_channel_config;
+
+dma_channel_config dma_channel_get_default_config(uint canal);
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size tamanho);
+void channel_config_set_read_increment(dma_channel_config *c, bool incrementa);
+void channel_config_set_write_increment(dma_channel_config *c, bool incrementa);
+void channel_config_set_dreq(dma_channel_config *c, uint dreq);
+
+int dma_claim_unused_channel(bool obrigatorio);
+void dma_channel_claim(uint canal);
+void dma_channel_unclaim(uint canal);
+void dma_channel_configure(uint canal, const dma_channel_config *c, volatile void *escrita,
+                           const volatile void *leitura, uint n, bool disparar);
+void dma_channel_set_read_addr(uint canal, const volatile void *leitura, bool disparar);
+void dma_start_channel_mask(uint32_t mascara);
+void dma_channel_abort(uint canal);
+bool dma_channel_is_busy(uint canal);
+
+void dma_irqn_set_channel_enabled(uint linha, uint canal, bool ativo);
+bool dma_irqn_get_channel_status(uint linha, uint canal);
+void dma_irqn_acknowledge_channel(uint linha, uint canal);
+
+#endif
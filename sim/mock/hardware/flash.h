@@ -0,0 +1,15 @@
+// SDK simulado: flash sem efeito (a calibração fica nos valores padrão).
+#ifndef SIM_HARDWARE_FLASH_H
+#define SIM_HARDWARE_FLASH_H
+
+#include "pico/stdlib.h"
+
+#define FLASH_PAGE_SIZE   256u
+#define FLASH_SECTOR_SIZE 4096u
+
+static inline void flash_range_erase(uint32_t offset, size_t n) { (void)offset; (void)n; }
+static inline void flash_range_program(uint32_t offset, const uint8_t *dados, size_t n) {
+    (void)offset; (void)dados; (void)n;
+}
+
+#endif
@@ -0,0 +1,16 @@
+// SDK simulado: GPIO sem efeito.
+#ifndef SIM_HARDWARE_GPIO_H
+#define SIM_HARDWARE_GPIO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef unsigned int uint;
+
+enum gpio_function { GPIO_FUNC_I2C = 3, GPIO_FUNC_PIO0 = 6, GPIO_FUNC_PIO1 = 7 };
+
+static inline void gpio_init(uint gpio) { (void)gpio; }
+static inline void gpio_set_function(uint gpio, enum gpio_function fn) { (void)gpio; (void)fn; }
+static inline void gpio_pull_up(uint gpio) { (void)gpio; }
+
+#endif
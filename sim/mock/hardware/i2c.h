@@ -0,0 +1,33 @@
+// SDK simulado: i2c1 ligado a um SSD1306 emulado (sdk_simulado.c).
+#ifndef SIM_HARDWARE_I2C_H
+#define SIM_HARDWARE_I2C_H
+
+#include "pico/stdlib.h"
+
+#define I2C_IC_DATA_CMD_STOP_BITS          0x200u
+#define I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS  0x40u
+#define I2C_IC_STATUS_ACTIVITY_BITS        0x1u
+#define I2C_IC_STATUS_TFE_BITS             0x4u
+
+typedef struct {
+    volatile uint32_t enable;
+    volatile uint32_t tar;
+    volatile uint32_t data_cmd;
+    volatile uint32_t raw_intr_stat;
+    volatile uint32_t clr_tx_abrt;
+    volatile uint32_t status;
+} i2c_hw_t;
+
+typedef struct i2c_inst {
+    i2c_hw_t hw;
+} i2c_inst_t;
+
+extern i2c_inst_t sim_i2c1;
+#define i2c1 (&sim_i2c1)
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t endereco, const uint8_t *dados, size_t n, bool sem_stop);
+static inline i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c) { return &i2c->hw; }
+static inline uint i2c_get_dreq(i2c_inst_t *i2c, bool tx) { (void)i2c; return tx ? 34 : 35; }
+
+#endif
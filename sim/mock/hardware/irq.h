@@ -0,0 +1,17 @@
+// SDK simulado: só as linhas do DMA chamam seus handlers (sdk_simulado.c).
+#ifndef SIM_HARDWARE_IRQ_H
+#define SIM_HARDWARE_IRQ_H
+
+#include "pico/stdlib.h"
+
+#define DMA_IRQ_0 11
+#define DMA_IRQ_1 12
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+
+typedef void (*irq_handler_t)(void);
+
+void irq_set_exclusive_handler(uint irq, irq_handler_t h);
+void irq_add_shared_handler(uint irq, irq_handler_t h, uint8_t prioridade);
+void irq_set_enabled(uint irq, bool ativa);
+
+#endif
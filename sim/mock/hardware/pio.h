@@ -0,0 +1,33 @@
+// SDK simulado: PIO cujo FIFO de TX alimenta uma fita WS2812 emulada.
+#ifndef SIM_HARDWARE_PIO_H
+#define SIM_HARDWARE_PIO_H
+
+#include "pico/stdlib.h"
+
+typedef struct {
+    volatile uint32_t txf[4];
+} pio_hw_t;
+
+typedef pio_hw_t *PIO;
+
+typedef struct {
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+} pio_program_t;
+
+extern pio_hw_t sim_pio0;
+#define pio0 (&sim_pio0)
+
+static inline uint pio_add_program(PIO pio, const pio_program_t *programa) {
+    (void)pio; (void)programa;
+    return 0;
+}
+static inline void pio_sm_claim(PIO pio, uint sm) { (void)pio; (void)sm; }
+static inline void pio_sm_unclaim(PIO pio, uint sm) { (void)pio; (void)sm; }
+int pio_claim_unused_sm(PIO pio, bool obrigatorio);
+static inline void pio_sm_set_enabled(PIO pio, uint sm, bool ativa) { (void)pio; (void)sm; (void)ativa; }
+static inline void pio_enable_sm_mask_in_sync(PIO pio, uint32_t mascara) { (void)pio; (void)mascara; }
+static inline uint pio_get_dreq(PIO pio, uint sm, bool tx) { (void)pio; return tx ? sm : sm + 4; }
+
+#endif
@@ -0,0 +1,5 @@
+// SDK simulado: binary_info não tem efeito no host.
+#ifndef SIM_PICO_BINARY_INFO_H
+#define SIM_PICO_BINARY_INFO_H
+#define bi_decl(x)
+#endif
@@ -0,0 +1,13 @@
+// SDK simulado: sem outro núcleo a estacionar, a função roda direto.
+#ifndef SIM_PICO_FLASH_H
+#define SIM_PICO_FLASH_H
+
+#include "pico/stdlib.h"
+
+static inline int flash_safe_execute(void (*fn)(void *), void *param, uint32_t timeout_ms) {
+    (void)timeout_ms;
+    fn(param);
+    return PICO_OK;
+}
+
+#endif
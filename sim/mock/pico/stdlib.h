@@ -0,0 +1,57 @@
+// SDK simulado (build de host): tipos e tempo do pico_stdlib.
+// O relógio é virtual: só avança em sleep_*, tight_loop_contents()
+// e sim_tempo_avancar_us() (sdk_simulado.h).
+#ifndef SIM_PICO_STDLIB_H
+#define SIM_PICO_STDLIB_H
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+
+#define _u(x) x##u
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#define __not_in_flash_func(f) f
+#define __time_critical_func(f) f
+#define PICO_ERROR_TIMEOUT (-1)
+#define PICO_OK 0
+#define XIP_BASE 0x10000000u
+#define PICO_FLASH_SIZE_BYTES (2u * 1024 * 1024)
+#define nil_time 0
+#define at_the_end_of_time UINT64_MAX
+
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+void sleep_until(absolute_time_t t);
+void tight_loop_contents(void);   // Avança 1 µs: laços de espera terminam
+
+static inline absolute_time_t get_absolute_time(void) { return time_us_64(); }
+static inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+static inline uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000); }
+static inline absolute_time_t from_us_since_boot(uint64_t us) { return us; }
+static inline absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us) { return t + us; }
+static inline absolute_time_t delayed_by_ms(absolute_time_t t, uint32_t ms) { return t + (uint64_t)ms * 1000; }
+static inline absolute_time_t make_timeout_time_us(uint64_t us) { return time_us_64() + us; }
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) { return time_us_64() + (uint64_t)ms * 1000; }
+static inline int64_t absolute_time_diff_us(absolute_time_t de, absolute_time_t ate) { return (int64_t)(ate - de); }
+static inline bool time_reached(absolute_time_t t) { return time_us_64() >= t; }
+static inline bool is_nil_time(absolute_time_t t) { return t == 0; }
+
+static inline bool stdio_init_all(void) { return true; }
+static inline int getchar_timeout_us(uint32_t us) { (void)us; return PICO_ERROR_TIMEOUT; }
+
+static inline void __wfi(void) { tight_loop_contents(); }
+static inline void __wfe(void) { tight_loop_contents(); }
+static inline void __sev(void) {}
+static inline void __dmb(void) {}
+static inline void __compiler_memory_barrier(void) {}
+
+#include "hardware/gpio.h"
+
+#endif
@@ -0,0 +1,344 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: sim/mock/sdk_simulado.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Implementação mínima do SDK para o build de host. Só o
+ *      que os módulos simulados usam: tempo, ADC, DMA, i2c1 e
+ *      PIO. O DMA termina a transferência no próprio disparo,
+ *      de modo que nenhuma espera por periférico fica presa, e
+ *      em seguida chama o handler da linha do canal, se o canal
+ *      e a linha estiverem habilitados.
+ *
+ *      O SSD1306 emulado interpreta o fluxo de controle
+ *      (0x00/0x80 comandos, 0x40 dados), os comandos de janela
+ *      (0x21/0x22) e grava os dados no modo horizontal, como o
+ *      painel real.
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/i2c.h"
+#include "hardware/irq.h"
+#include "hardware/pio.h"
+#include "sdk_simulado.h"
+
+#define OLED_LARGURA 128
+#define OLED_PAGINAS 8
+#define FITA_MAX     64
+
+i2c_inst_t sim_i2c1 = { .hw = { .status = I2C_IC_STATUS_TFE_BITS } };
+pio_hw_t sim_pio0;
+
+// Fim da imagem para mapa_flash_livre(): no host, endereço fora da flash
+char __flash_binary_end;
+
+// --- Tempo ---
+
+static uint64_t agora_us = 0;
+
+uint64_t time_us_64(void) { return agora_us; }
+uint32_t time_us_32(void) { return (uint32_t)agora_us; }
+void sim_tempo_avancar_us(uint64_t us) { agora_us += us; }
+void sleep_us(uint64_t us) { agora_us += us; }
+void sleep_ms(uint32_t ms) { agora_us += (uint64_t)ms * 1000; }
+void sleep_until(absolute_time_t t) { if (t > agora_us) agora_us = t; }
+void tight_loop_contents(void) { agora_us++; }
+
+// --- ADC ---
+
+static sim_fonte_adc_t fonte_adc = NULL;
+static void *contexto_adc = NULL;
+static uint entrada_adc = 0;
+static uint mascara_rr = 0;
+
+void sim_adc_definir_fonte(sim_fonte_adc_t fonte, void *ctx) {
+    fonte_adc = fonte;
+    contexto_adc = ctx;
+}
+
+void adc_init(void) {}
+void adc_gpio_init(uint gpio) { (void)gpio; }
+void adc_select_input(uint entrada) { entrada_adc = entrada; }
+uint adc_get_selected_input(void) { return entrada_adc; }
+void adc_set_temp_sensor_enabled(bool ativo) { (void)ativo; }
+void adc_set_round_robin(uint mascara) { mascara_rr = mascara & 0x1F; }
+
+uint16_t adc_read(void) {
+    agora_us += SIM_ADC_CONVERSAO_US;
+    uint16_t v = fonte_adc ? fonte_adc((uint8_t)entrada_adc, agora_us, contexto_adc) & 0x0FFF : 0;
+
+    // Round-robin: avança para a próxima entrada habilitada
+    if (mascara_rr) {
+        do { entrada_adc = (entrada_adc + 1) % 5; } while (!(mascara_rr & (1u << entrada_adc)));
+    }
+    return v;
+}
+
+// --- SSD1306 emulado ---
+
+static uint8_t gddram[OLED_PAGINAS * OLED_LARGURA];
+static uint32_t i2c_bytes = 0, i2c_transacoes = 0;
+
+static enum { CONTROLE, COMANDO_UNICO, COMANDOS, DADOS } estado_i2c = CONTROLE;
+static uint8_t cmd[8];
+static uint8_t cmd_n = 0, cmd_esperado = 0;
+static uint8_t col_ini = 0, col_fim = OLED_LARGURA - 1, col = 0;
+static uint8_t pag_ini = 0, pag_fim = OLED_PAGINAS - 1, pag = 0;
+
+static uint8_t argumentos(uint8_t c) {
+    switch (c) {
+        case 0x21: case 0x22: case 0xA3: return 2;
+        case 0x26: case 0x27: return 6;
+        case 0x29: case 0x2A: return 5;
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB: return 1;
+        default: return 0;
+    }
+}
+
+static void executar_comando(void) {
+    switch (cmd[0]) {
+        case 0x21:
+            col_ini = cmd[1] % OLED_LARGURA; col_fim = cmd[2] % OLED_LARGURA; col = col_ini;
+            break;
+        case 0x22:
+            pag_ini = cmd[1] % OLED_PAGINAS; pag_fim = cmd[2] % OLED_PAGINAS; pag = pag_ini;
+            break;
+        default:
+            break;   // Demais comandos não alteram a GDDRAM
+    }
+}
+
+static void oled_comando(uint8_t b) {
+    if (cmd_n == 0) cmd_esperado = argumentos(b);
+    cmd[cmd_n++] = b;
+    if (cmd_n > cmd_esperado) {
+        executar_comando();
+        cmd_n = 0;
+    }
+}
+
+static void oled_dado(uint8_t b) {
+    gddram[pag * OLED_LARGURA + col] = b;
+    if (col++ >= col_fim) {
+        col = col_ini;
+        pag = (pag >= pag_fim) ? pag_ini : pag + 1;
+    }
+}
+
+static void oled_byte(uint8_t b, bool fim) {
+    i2c_bytes++;
+    switch (estado_i2c) {
+        case CONTROLE:
+            if (b & 0x80) estado_i2c = COMANDO_UNICO;    // Co = 1: um byte e novo controle
+            else estado_i2c = (b & 0x40) ? DADOS : COMANDOS;
+            break;
+        case COMANDO_UNICO: oled_comando(b); estado_i2c = CONTROLE; break;
+        case COMANDOS:      oled_comando(b); break;
+        case DADOS:         oled_dado(b);    break;
+    }
+    if (fim) {
+        estado_i2c = CONTROLE;
+        i2c_transacoes++;
+    }
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    (void)i2c;
+    return baudrate;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t endereco, const uint8_t *dados, size_t n, bool sem_stop) {
+    (void)i2c; (void)endereco;
+    for (size_t i = 0; i < n; i++) oled_byte(dados[i], i + 1 == n && !sem_stop);
+    return (int)n;
+}
+
+const uint8_t *sim_oled_gddram(void) { return gddram; }
+uint32_t sim_i2c_bytes(void) { return i2c_bytes; }
+uint32_t sim_i2c_transacoes(void) { return i2c_transacoes; }
+
+// --- Fita WS2812 emulada ---
+
+static uint32_t fita[FITA_MAX];
+static uint32_t fita_n = 0, fita_recebendo = 0;
+static uint32_t pio_bytes = 0, pio_quadros = 0;
+
+static void fita_palavra(uint32_t w) {
+    if (fita_recebendo < FITA_MAX) fita[fita_recebendo++] = w;
+    pio_bytes += 3;
+}
+
+static void fita_fim_quadro(void) {
+    fita_n = fita_recebendo;
+    fita_recebendo = 0;
+    pio_quadros++;
+}
+
+const uint32_t *sim_fita_quadro(uint32_t *n) {
+    *n = fita_n;
+    return fita;
+}
+uint32_t sim_pio_bytes(void) { return pio_bytes; }
+uint32_t sim_pio_quadros(void) { return pio_quadros; }
+
+static uint32_t sm_reservadas = 0;
+
+int pio_claim_unused_sm(PIO pio, bool obrigatorio) {
+    (void)pio;
+    for (int sm = 0; sm < 4; sm++) {
+        if (!(sm_reservadas & (1u << sm))) {
+            sm_reservadas |= 1u << sm;
+            return sm;
+        }
+    }
+    assert(!obrigatorio);
+    return -1;
+}
+
+// --- DMA ---
+
+typedef struct {
+    dma_channel_config cfg;
+    volatile void *escrita;
+    const volatile void *leitura;
+    uint n;
+    bool reservado;
+} canal_simulado_t;
+
+static canal_simulado_t canais[NUM_DMA_CHANNELS];
+
+// Duas linhas de interrupção do DMA
+static uint32_t irq_habilitados[2];
+static uint32_t irq_status[2];
+static irq_handler_t irq_handler[2];
+static bool irq_linha_ativa[2];
+
+static int linha_dma(uint irq) {
+    return irq == DMA_IRQ_0 ? 0 : irq == DMA_IRQ_1 ? 1 : -1;
+}
+
+void irq_set_exclusive_handler(uint irq, irq_handler_t h) {
+    int l = linha_dma(irq);
+    if (l >= 0) irq_handler[l] = h;
+}
+
+void irq_add_shared_handler(uint irq, irq_handler_t h, uint8_t prioridade) {
+    (void)prioridade;
+    irq_set_exclusive_handler(irq, h);   // Um só usuário por linha no host
+}
+
+void irq_set_enabled(uint irq, bool ativa) {
+    int l = linha_dma(irq);
+    if (l >= 0) irq_linha_ativa[l] = ativa;
+}
+
+void dma_irqn_set_channel_enabled(uint linha, uint canal, bool ativo) {
+    if (ativo) irq_habilitados[linha] |= 1u << canal;
+    else irq_habilitados[linha] &= ~(1u << canal);
+}
+
+bool dma_irqn_get_channel_status(uint linha, uint canal) {
+    return (irq_status[linha] >> canal) & 1u;
+}
+
+void dma_irqn_acknowledge_channel(uint linha, uint canal) {
+    irq_status[linha] &= ~(1u << canal);
+}
+
+static void concluir(uint canal) {
+    for (uint l = 0; l < 2; l++) {
+        if (!(irq_habilitados[l] & (1u << canal))) continue;
+        irq_status[l] |= 1u << canal;
+        if (irq_linha_ativa[l] && irq_handler[l]) irq_handler[l]();
+    }
+}
+
+static bool destino_pio(volatile void *p) {
+    return (volatile uint8_t *)p >= (volatile uint8_t *)&sim_pio0.txf[0] &&
+           (volatile uint8_t *)p <= (volatile uint8_t *)&sim_pio0.txf[3];
+}
+
+static void transferir(canal_simulado_t *c) {
+    uint tam = 1u << c->cfg.tamanho;
+    const volatile uint8_t *r = c->leitura;
+    volatile uint8_t *w = c->escrita;
+
+    for (uint i = 0; i < c->n; i++) {
+        uint32_t v = 0;
+        memcpy(&v, (const void *)r, tam);
+
+        if (c->escrita == &sim_i2c1.hw.data_cmd) {
+            oled_byte((uint8_t)v, (v & I2C_IC_DATA_CMD_STOP_BITS) != 0);
+        } else if (destino_pio(c->escrita)) {
+            fita_palavra(v);
+        } else {
+            memcpy((void *)w, &v, tam);
+        }
+
+        if (c->cfg.incrementa_leitura) r += tam;
+        if (c->cfg.incrementa_escrita) w += tam;
+    }
+    if (destino_pio(c->escrita)) fita_fim_quadro();
+}
+
+dma_channel_config dma_channel_get_default_config(uint canal) {
+    (void)canal;
+    return (dma_channel_config){ .tamanho = DMA_SIZE_32, .incrementa_leitura = true };
+}
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size t) { c->tamanho = t; }
+void channel_config_set_read_increment(dma_channel_config *c, bool inc) { c->incrementa_leitura = inc; }
+void channel_config_set_write_increment(dma_channel_config *c, bool inc) { c->incrementa_escrita = inc; }
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) { c->dreq = dreq; }
+
+int dma_claim_unused_channel(bool obrigatorio) {
+    for (int i = NUM_DMA_CHANNELS - 1; i >= 0; i--) {
+        if (!canais[i].reservado) {
+            canais[i].reservado = true;
+            return i;
+        }
+    }
+    assert(!obrigatorio);
+    return -1;
+}
+void dma_channel_claim(uint canal) { canais[canal].reservado = true; }
+void dma_channel_unclaim(uint canal) { canais[canal].reservado = false; }
+
+void dma_channel_configure(uint canal, const dma_channel_config *c, volatile void *escrita,
+                           const volatile void *leitura, uint n, bool disparar) {
+    canais[canal].cfg = *c;
+    canais[canal].escrita = escrita;
+    canais[canal].leitura = leitura;
+    canais[canal].n = n;
+    if (disparar) {
+        transferir(&canais[canal]);
+        concluir(canal);
+    }
+}
+
+void dma_channel_set_read_addr(uint canal, const volatile void *leitura, bool disparar) {
+    canais[canal].leitura = leitura;
+    if (disparar) {
+        transferir(&canais[canal]);
+        concluir(canal);
+    }
+}
+
+void dma_start_channel_mask(uint32_t mascara) {
+    for (uint canal = 0; canal < NUM_DMA_CHANNELS; canal++) {
+        if (!(mascara & (1u << canal))) continue;
+        transferir(&canais[canal]);
+        concluir(canal);
+    }
+}
+
+void dma_channel_abort(uint canal) { (void)canal; }
+bool dma_channel_is_busy(uint canal) { (void)canal; return false; }
@@ -0,0 +1,40 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: sim/mock/sdk_simulado.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Interface dos periféricos simulados do build de host
+ *      (TEMPCYCLE_SIMULACAO): relógio virtual, ADC alimentado
+ *      por uma função, SSD1306 emulado no i2c1 e fita WS2812
+ *      emulada no FIFO da PIO, com contagem de bytes.
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef SDK_SIMULADO_H
+#define SDK_SIMULADO_H
+
+#include <stdint.h>
+
+#define SIM_ADC_CONVERSAO_US 2   // 96 ciclos a 48 MHz
+
+// Gera uma amostra bruta (12 bits) da entrada no instante virtual t_us
+typedef uint16_t (*sim_fonte_adc_t)(uint8_t entrada, uint64_t t_us, void *ctx);
+
+void sim_tempo_avancar_us(uint64_t us);
+void sim_adc_definir_fonte(sim_fonte_adc_t fonte, void *ctx);
+
+// GDDRAM do painel emulado: 8 páginas × 128 colunas, como ssd[]
+const uint8_t *sim_oled_gddram(void);
+uint32_t sim_i2c_bytes(void);         // Bytes de dados (controle + payload)
+uint32_t sim_i2c_transacoes(void);
+
+// Último quadro recebido pela fita (palavras como enviadas ao FIFO)
+const uint32_t *sim_fita_quadro(uint32_t *n);
+uint32_t sim_pio_bytes(void);         // Bytes no fio (3 por LED)
+uint32_t sim_pio_quadros(void);
+
+#endif  // SDK_SIMULADO_H
@@ -0,0 +1,17 @@
+// SDK simulado: substitui o cabeçalho gerado por pioasm.
+#ifndef SIM_WS2818B_PIO_H
+#define SIM_WS2818B_PIO_H
+
+#include "hardware/pio.h"
+
+static const pio_program_t ws2818b_program = { 0 };
+
+static inline void ws2818b_program_config(PIO pio, uint sm, uint offset, uint pin, float freq) {
+    (void)pio; (void)sm; (void)offset; (void)pin; (void)freq;
+}
+
+static inline void ws2818b_program_init(PIO pio, uint sm, uint offset, uint pin, float freq) {
+    (void)pio; (void)sm; (void)offset; (void)pin; (void)freq;
+}
+
+#endif
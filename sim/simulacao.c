@@ -0,0 +1,222 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: sim/simulacao.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Programa do build de host (TEMPCYCLE_SIMULACAO). Roda
+ *      o ciclo de 1 s do firmware sobre o SDK simulado: a
+ *      janela da Tarefa 1 lê um fluxo sintético do ADC
+ *      (perfil de temperatura com ruído, semente fixa), e as
+ *      Tarefas 3, 2, 4 e 5 são as do firmware, nos ticks de
+ *      10 ms da tabela de main.c.
+ *
+ *      A cada ciclo imprime uma linha CSV com a temperatura,
+ *      a tendência e os bytes no I2C e na PIO; com -o grava
+ *      também o painel emulado (oled_NNNN.pbm) e a matriz
+ *      (leds_NNNN.ppm), que servem de referência para testes
+ *      de renderização. A coluna oled_difere conta os bytes em
+ *      que o painel difere de ssd[] ao fim do ciclo (deve ser 0).
+ *
+ *      Uso: TempCycleDMA_sim [-c ciclos] [-n amostras] [-o dir]
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "sdk_simulado.h"
+
+#include "calibracao.h"
+#include "dma_servico.h"
+#include "tarefa2_display.h"
+#include "tarefa3_tendencia.h"
+#include "tarefa4_controla_neopixel.h"
+#include "testes_cores.h"
+#include "neopixel_driver.h"
+#include "efeitos.h"
+#include "ssd1306.h"
+
+#define TICK_US          10000
+#define TICKS_CICLO      100
+#define PERIODO_T2       50      // Mesmo período e fase da tabela de main.c
+#define FASE_T2          5
+#define PERIODO_T4       3
+#define AMOSTRAS_PADRAO  250000  // 0,5 s a 500 kS/s
+#define ESCALA_LED       16      // Pixels por LED no PPM
+#define RUIDO_LSB        2.0
+
+// Framebuffer com o byte de controle à frente, como em setup.c
+static uint8_t ssd_com_controle[1 + ssd1306_buffer_length];
+uint8_t *const ssd = ssd_com_controle + 1;
+
+static uint32_t semente = 12345;
+
+// Gerador congruente: mesma sequência em qualquer host
+static double aleatorio_0a1(void) {
+    semente = semente * 1103515245u + 12345u;
+    return ((semente >> 8) + 0.5) / 16777216.0;
+}
+
+static double gaussiana(void) {
+    return sqrt(-2.0 * log(aleatorio_0a1())) * cos(2.0 * M_PI * aleatorio_0a1());
+}
+
+// Perfil de referência: estável, sobe, estável, desce abaixo de 1 °C, estável
+static double perfil_celsius(double t_s) {
+    if (t_s < 20)  return 25.0;
+    if (t_s < 40)  return 25.0 + (t_s - 20) * 0.5;
+    if (t_s < 60)  return 35.0;
+    if (t_s < 100) return 35.0 - (t_s - 60) * 0.875;
+    return 0.0;
+}
+
+// Curva nominal do sensor interno, invertida: °C → código do ADC
+static uint16_t fonte_sensor(uint8_t entrada, uint64_t t_us, void *ctx) {
+    (void)entrada; (void)ctx;
+    double v = 0.706 - (perfil_celsius(t_us / 1e6) - 27.0) * 0.001721;
+    double codigo = v * 4096.0 / 3.3 + gaussiana() * RUIDO_LSB;
+    if (codigo < 0) codigo = 0;
+    if (codigo > 4095) codigo = 4095;
+    return (uint16_t)lround(codigo);
+}
+
+static void gravar_pbm(const char *dir, uint32_t ciclo) {
+    char nome[512];
+    snprintf(nome, sizeof(nome), "%s/oled_%04lu.pbm", dir, (unsigned long)ciclo);
+    FILE *f = fopen(nome, "wb");
+    if (!f) return;
+
+    const uint8_t *g = sim_oled_gddram();
+    fprintf(f, "P4\n%d %d\n", ssd1306_width, ssd1306_height);
+    for (int y = 0; y < ssd1306_height; y++) {
+        for (int x0 = 0; x0 < ssd1306_width; x0 += 8) {
+            uint8_t byte = 0;
+            for (int b = 0; b < 8; b++) {
+                if (g[(y / 8) * ssd1306_width + x0 + b] & (1u << (y % 8))) byte |= 0x80 >> b;
+            }
+            fputc(byte, f);
+        }
+    }
+    fclose(f);
+}
+
+static void gravar_ppm(const char *dir, uint32_t ciclo) {
+    char nome[512];
+    snprintf(nome, sizeof(nome), "%s/leds_%04lu.ppm", dir, (unsigned long)ciclo);
+    FILE *f = fopen(nome, "wb");
+    if (!f) return;
+
+    fprintf(f, "P6\n%d %d\n255\n", NUM_COLUNAS * ESCALA_LED, NUM_LINHAS * ESCALA_LED);
+    for (int py = 0; py < NUM_LINHAS * ESCALA_LED; py++) {
+        for (int px = 0; px < NUM_COLUNAS * ESCALA_LED; px++) {
+            const npLED_t *led = &leds[getLEDIndex(px / ESCALA_LED, py / ESCALA_LED)];
+            fputc(led->R, f);
+            fputc(led->G, f);
+            fputc(led->B, f);
+        }
+    }
+    fclose(f);
+}
+
+static uint32_t oled_diferencas(void) {
+    const uint8_t *g = sim_oled_gddram();
+    uint32_t n = 0;
+    for (int i = 0; i < ssd1306_buffer_length; i++) n += g[i] != ssd[i];
+    return n;
+}
+
+int main(int argc, char **argv) {
+    uint32_t ciclos = 120;
+    uint32_t amostras = AMOSTRAS_PADRAO;
+    const char *dir = NULL;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "-c")) ciclos = (uint32_t)strtoul(argv[i + 1], NULL, 10);
+        else if (!strcmp(argv[i], "-n")) amostras = (uint32_t)strtoul(argv[i + 1], NULL, 10);
+        else if (!strcmp(argv[i], "-o")) dir = argv[i + 1];
+    }
+    if (amostras == 0) amostras = 1;
+    uint32_t amostras_tick = TICK_US / SIM_ADC_CONVERSAO_US;
+
+    sim_adc_definir_fonte(fonte_sensor, NULL);
+    adc_select_input(4);
+
+    ssd1306_init();
+    ssd1306_async_init();
+    static const uint pinos_matriz[] = { NP_PINOS };
+    _Static_assert(sizeof(pinos_matriz) / sizeof(pinos_matriz[0]) == NP_FITAS,
+                   "NP_PINOS deve listar exatamente NP_FITAS pinos");
+    npInitFitas(pinos_matriz, NP_FITAS);
+    dma_servico_habilitar_linha(DMA_SERVICO_LINHA_SAIDA);
+
+    float media = 0.0f;
+    tendencia_t t = TENDENCIA_ESTÁVEL;
+    uint64_t total_i2c = 0, total_pio = 0;
+
+    printf("ciclo,temp_ref_c,temp_c,tendencia,bytes_i2c,transacoes_i2c,bytes_pio,quadros_pio,oled_difere\n");
+    for (uint32_t c = 0; c < ciclos; c++) {
+        uint64_t inicio = time_us_64();
+        double referencia = perfil_celsius(inicio / 1e6);
+        uint32_t i2c0 = sim_i2c_bytes(), tr0 = sim_i2c_transacoes();
+        uint32_t pio0_bytes = sim_pio_bytes(), q0 = sim_pio_quadros();
+
+        uint64_t soma = 0;
+        uint32_t lidas = 0;
+        for (uint32_t tick = 0; tick < TICKS_CICLO; tick++) {
+            uint64_t fim_tick = inicio + (uint64_t)(tick + 1) * TICK_US;
+
+            // Tarefa 1: a janela avança em paralelo com os ticks
+            if (lidas < amostras) {
+                uint32_t n = amostras - lidas < amostras_tick ? amostras - lidas : amostras_tick;
+                for (uint32_t k = 0; k < n; k++) soma += adc_read();
+                lidas += n;
+
+                if (lidas == amostras) {   // Fim da janela: Tarefas 5 e 3
+                    media = calibracao_bruto_para_centi(soma, amostras) / 100.0f;
+                    if (media < 1.0f) efeitoIniciarNaCamada(NP_CAMADA_ALERTA, quadroPiscar, COR_BRANCA, 100);
+                    t = tarefa3_analisa_tendencia(media);
+                    const tarefa3_resultado_t *analise = tarefa3_resultado();
+                    tarefa2_registrar_leitura(lroundf(media * 100.0f), analise->minimo_centi,
+                                              analise->maximo_centi);
+                }
+            }
+
+            if (tick % PERIODO_T4 == 0) {
+                efeitoServico();
+                tarefa4_matriz_cor_por_tendencia(t);
+            }
+            if (tick % PERIODO_T2 == FASE_T2) {
+                tarefa2_exibir_oled(media, t);
+            }
+
+            sleep_until(fim_tick);
+        }
+
+        uint32_t bytes_i2c = sim_i2c_bytes() - i2c0;
+        uint32_t bytes_pio = sim_pio_bytes() - pio0_bytes;
+        total_i2c += bytes_i2c;
+        total_pio += bytes_pio;
+
+        printf("%lu,%.2f,%.2f,%s,%lu,%lu,%lu,%lu,%lu\n", (unsigned long)c, referencia, media,
+               tendencia_para_texto(t), (unsigned long)bytes_i2c,
+               (unsigned long)(sim_i2c_transacoes() - tr0), (unsigned long)bytes_pio,
+               (unsigned long)(sim_pio_quadros() - q0), (unsigned long)oled_diferencas());
+
+        if (dir) {
+            gravar_pbm(dir, c);
+            gravar_ppm(dir, c);
+        }
+    }
+
+    fprintf(stderr, "%lu ciclos: %.1f bytes I2C/ciclo, %.1f bytes PIO/ciclo\n",
+            (unsigned long)ciclos, ciclos ? (double)total_i2c / ciclos : 0.0,
+            ciclos ? (double)total_pio / ciclos : 0.0);
+    return 0;
+}
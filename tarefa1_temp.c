@@ -1,108 +1,645 @@
-/**
- * ------------------------------------------------------------
- *  Arquivo: tarefa1_temp.c
- *  Projeto: TempCycleDMA
- * ------------------------------------------------------------
- *  Descrição:
- *      Este módulo implementa a Tarefa 1 do executor cíclico,
- *      responsável por realizar a leitura do sensor interno
- *      de temperatura utilizando ADC + DMA, durante um intervalo
- *      contínuo de 0,5 segundos.
- *
- *      A leitura é feita em blocos menores (10.000 amostras)
- *      para evitar o uso excessivo da SRAM do RP2040. Cada
- *      bloco é transferido via DMA e processado de forma
- *      incremental para obter a média da temperatura ao final
- *      do intervalo total.
- *
- *  Funcionalidades:
- *      - Converte valores brutos do ADC para graus Celsius.
- *      - Controla o tempo de aquisição com precisão usando
- *        o clock interno via 'get_absolute_time()'.
- *      - Utiliza DMA canal 0 e depende da flag 'dma_temp_done'
- *        sinalizada pelo handler definido em 'irq_handlers.c'.
- *
- *  Relacionamento:
- *      - Chamado pelo laço principal em 'main.c' como tarefa do ciclo.
- *      - Requer configuração do canal DMA e IRQ em 'setup.c'.
- *
- *  
- *  Data: 11/05/2025
- * ------------------------------------------------------------
- */
-
-#include "pico/stdlib.h"
-#include "hardware/adc.h"
-#include "hardware/dma.h"
-#include "hardware/sync.h"
-#include "tarefa1_temp.h"
-
-#define BLOCO_AMOSTRAS 10000
-#define DURACAO_AMOSTRAGEM_US 500000  // 0,5 segundos em microssegundos
-
-static uint16_t buffer_temp[BLOCO_AMOSTRAS];
-extern volatile bool dma_temp_done;
-
-/**
- * @brief Converte valor do ADC para temperatura em °C.
- * 
- * @param raw Valor bruto de 12 bits lido do ADC.
- * @return float Temperatura em graus Celsius.
- */
-static float convert_to_celsius(uint16_t raw) {
-    const float conv = 3.3f / (1 << 12);  // Conversão para tensão
-    float voltage = raw * conv;
-    return 27.0f - (voltage - 0.706f) / 0.001721f;
-}
-
-/**
- * @brief Inicia uma transferência via DMA de um bloco do sensor de temperatura.
- *
- * @param buffer Buffer de destino.
- * @param cfg Configuração do canal DMA.
- * @param dma_chan Canal DMA utilizado.
- */
-static void iniciar_dma_temp(uint16_t *buffer, dma_channel_config *cfg, int dma_chan) {
-    adc_select_input(4);           // Canal 4 → sensor interno
-    adc_fifo_drain();
-    adc_run(false);
-    adc_fifo_setup(true, true, 1, false, false);
-    adc_run(true);
-
-    dma_channel_configure(
-        dma_chan,
-        cfg,
-        buffer, &adc_hw->fifo,
-        BLOCO_AMOSTRAS,
-        true
-    );
-}
-
-/**
- * @brief Executa a Tarefa 1 do executor cíclico: coleta de temperatura por 0,5s.
- *
- * @param cfg_temp Configuração do canal DMA.
- * @param dma_chan Número do canal DMA utilizado.
- * @return float Temperatura média calculada ao final do intervalo.
- */
-float tarefa1_obter_media_temp(dma_channel_config* cfg_temp, int dma_chan) {
-    float soma = 0.0f;
-    uint32_t total_amostras = 0;
-
-    absolute_time_t inicio = get_absolute_time();
-
-    while (absolute_time_diff_us(inicio, get_absolute_time()) < DURACAO_AMOSTRAGEM_US) {
-        dma_temp_done = false;
-        iniciar_dma_temp(buffer_temp, cfg_temp, dma_chan);
-        while (!dma_temp_done) __wfi();  // Aguarda fim do DMA
-        adc_run(false); // Desliga o ADC
-
-        for (int i = 0; i < BLOCO_AMOSTRAS; i++) {
-            soma += convert_to_celsius(buffer_temp[i]);
-        }
-
-        total_amostras += BLOCO_AMOSTRAS;
-    }
-
-    return soma / total_amostras;
-}
\ No newline at end of file
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: tarefa1_temp.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Este módulo implementa a Tarefa 1 do executor cíclico,
+ *      responsável por realizar a leitura do sensor interno
+ *      de temperatura utilizando ADC + DMA, durante um intervalo
+ *      contínuo de 0,5 segundos.
+ *
+ *      A leitura é feita em ping-pong: dois canais DMA
+ *      encadeados entre si enchem alternadamente as duas
+ *      metades de 'buffer_temp' (5.000 amostras cada, mesma
+ *      SRAM do bloco único anterior). Enquanto uma metade é
+ *      preenchida, a CPU reduz a outra, de modo que o ADC
+ *      amostra continuamente durante todo o intervalo, sem
+ *      lacunas entre blocos.
+ *
+ *      Com TAREFA1_USAR_SNIFFER (setup.h), não há buffer de
+ *      amostras: o sniffer do DMA soma os valores brutos em
+ *      hardware enquanto o canal escreve sempre sobre a mesma
+ *      palavra descartável, e a CPU só converte a média final.
+ *
+ *      A aquisição é assíncrona: tarefa1_iniciar() dispara a
+ *      janela e retorna; tarefa1_pronta() é chamada pelo laço
+ *      principal, soma as metades já entregues pelo DMA e,
+ *      terminada a janela, encerra a captura. O resultado fica
+ *      disponível em tarefa1_resultado(). Assim o executor
+ *      cíclico não fica parado durante os 0,5 s de amostragem.
+ *
+ *      Entre as janelas o ADC e o sensor interno ficam
+ *      desligados. tarefa1_iniciar() os liga e agenda, por um
+ *      alarme, o início do DMA após ESTABILIZACAO_SENSOR_US; a
+ *      janela de 0,5 s começa só depois desse tempo. O alarme
+ *      mexe no estado da aquisição, por isso vem do pool do
+ *      núcleo que a conduz (tarefa1_usar_alarmes).
+ *
+ *      Quem dispara a janela pode limitá-la ao que resta do
+ *      ciclo (tarefa1_definir_orcamento): um disparo atrasado
+ *      gera uma janela mais curta, com menos amostras, e a
+ *      seguinte volta à duração configurada.
+ *
+ *      Taxa do ADC, duração da janela, tamanho do bloco e fator
+ *      de decimação são parâmetros de execução
+ *      (tarefa1_configurar). No ping-pong, a redução também
+ *      alimenta um boxcar (integra e descarta, CIC de 1ª ordem)
+ *      que gera o fluxo decimado de médias de 'decimacao'
+ *      amostras (tarefa1_decimadas). Com taxas baixas um bloco
+ *      pode não se completar na janela, por isso o bloco parcial
+ *      em andamento é somado ao final.
+ *
+ *      Com mais de um canal em 'canais', o ADC alterna as
+ *      entradas em round-robin (adc_set_round_robin) e a mesma
+ *      captura serve a todos: a redução separa o fluxo
+ *      intercalado por passo, em acumuladores por canal, e cada
+ *      canal é convertido pela sua função de calibração
+ *      (calibracao_canal_para_centi). O fluxo decimado só existe
+ *      com um canal, e o modo sniffer (que soma tudo em um único
+ *      acumulador) aceita apenas um canal.
+ *
+ *      Com a captura ligada (captura.h), cada metade já somada
+ *      é empacotada em 12 bits no próprio buffer e entregue
+ *      para o envio das amostras brutas pela USB.
+ *
+ *  Funcionalidades:
+ *      - Soma os códigos brutos de 12 bits em inteiro de 64 bits
+ *        e converte apenas a média final, em ponto fixo e com a
+ *        calibração do dispositivo (calibracao.c).
+ *      - Controla o tempo de aquisição com precisão usando
+ *        o clock interno via 'get_absolute_time()'.
+ *      - Utiliza os dois canais DMA reservados em 'setup.c' e
+ *        depende da máscara 'dma_temp_blocos_prontos'
+ *        sinalizada pelo callback definido em 'irq_handlers.c'.
+ *
+ *  Relacionamento:
+ *      - Chamado pelo laço principal em 'main.c' como tarefa do ciclo.
+ *      - Requer configuração do canal DMA e IRQ em 'setup.c'.
+ *
+ *  
+ *  Data: 11/05/2025
+ * ------------------------------------------------------------
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/sync.h"
+#include "calibracao.h"
+#include "captura.h"
+#include "dma_servico.h"
+#include "estatisticas.h"
+#include "irq_handlers.h"
+#include "setup.h"
+#include "tarefa1_temp.h"
+
+
+// Tempo entre ligar o ADC e o sensor e a primeira amostra. O datasheet
+// não especifica a partida do sensor; o valor é uma margem conservadora
+// (o ADC em si fica pronto em poucos ciclos).
+#define ESTABILIZACAO_SENSOR_US 200
+
+#define ADC_CLOCK_HZ      48000000    // clk_adc (PLL_USB)
+#define ADC_TAXA_MAX_SPS  500000      // 96 ciclos de clk_adc por conversão
+#define ADC_TAXA_MIN_SPS  1000
+
+#if TAREFA1_USAR_SNIFFER
+#define BLOCO_AMOSTRAS 50000          // Transferências entre interrupções do sniffer (padrão)
+
+static uint32_t amostra_descartada;   // Destino fixo das transferências
+#else
+#define BLOCO_AMOSTRAS TAREFA1_BLOCO_MAX   // Amostras por metade do ping-pong (padrão e máximo)
+
+static uint16_t buffer_temp[2][BLOCO_AMOSTRAS];
+static uint32_t blocos_janela;        // Blocos completos somados na janela
+static uint32_t concluidos_inicio;    // dma_temp_blocos_concluidos no início da janela
+
+_Static_assert(TAREFA1_BLOCO_MAX <= CAPTURA_BLOCO_MAX, "bloco maior que o da captura");
+#endif
+
+static tarefa1_parametros_t parametros = {
+    .taxa_sps = ADC_TAXA_MAX_SPS,
+    .duracao_us = 500000,             // 0,5 segundos em microssegundos
+    .bloco = BLOCO_AMOSTRAS,
+    .decimacao = 2500,                // 200 saídas/s a 500 ksps
+    .canais = 1u << TAREFA1_CANAL_SENSOR,
+};
+
+// Parâmetros agendados por outro núcleo (tarefa1_agendar_configuracao)
+static tarefa1_parametros_t agendados;
+static volatile bool agendamento_pendente = false;
+
+// Sequência do round-robin (ordem crescente a partir do menor canal)
+static uint8_t seq_canais[TAREFA1_CANAIS];
+static uint32_t num_canais;
+static uint32_t fase_rr;              // Posição na sequência da próxima amostra
+static uint64_t soma_canal[TAREFA1_CANAIS];
+static uint32_t amostras_canal[TAREFA1_CANAIS];
+
+// Fluxo decimado da janela em andamento
+static uint16_t decimadas[TAREFA1_DECIMADAS_MAX];
+static uint32_t num_decimadas;
+static uint32_t decim_soma;           // Cabe em 32 bits: decimacao ≤ 65.535 × 4.095
+static uint32_t decim_contagem;
+
+// Estado da janela de aquisição em andamento
+static bool em_andamento = false;
+static bool concluida = false;
+static absolute_time_t fim_janela;
+static uint32_t duracao_janela_us;
+static uint32_t orcamento_us = UINT32_MAX;   // Só para a próxima janela
+static uint32_t janelas_encurtadas = 0;
+static int canal_a_ativo, canal_b_ativo;
+static uint64_t soma_bruta;
+static uint32_t total_amostras;
+static uint proxima;
+static tarefa1_resultado_t resultado;
+static dma_channel_config *cfg_a_ativa, *cfg_b_ativa;
+static absolute_time_t sensor_ligado_em;
+static uint64_t sensor_tempo_ligado_us = 0;
+
+/**
+ * @brief Liga o ADC e o sensor interno de temperatura.
+ */
+static void ligar_sensor(void) {
+    hw_set_bits(&adc_hw->cs, ADC_CS_EN_BITS);
+    adc_set_temp_sensor_enabled(true);
+    sensor_ligado_em = get_absolute_time();
+}
+
+/**
+ * @brief Desliga o sensor e o ADC até a próxima janela.
+ */
+static void desligar_sensor(void) {
+    adc_set_temp_sensor_enabled(false);
+    hw_clear_bits(&adc_hw->cs, ADC_CS_EN_BITS);
+    sensor_tempo_ligado_us += absolute_time_diff_us(sensor_ligado_em, get_absolute_time());
+}
+
+#if TAREFA1_USAR_SNIFFER
+
+/**
+ * @brief Inicia a aquisição com soma no sniffer.
+ *
+ * O canal é re-disparado pelo handler a cada 'parametros.bloco' transferências enquanto
+ * 'dma_temp_sniffer_ativo' estiver ligado.
+ *
+ * @param cfg Configuração do canal (sniffer habilitado).
+ * @param canal Canal DMA observado pelo sniffer.
+ */
+static void iniciar_dma_temp(dma_channel_config *cfg, int canal) {
+    adc_select_input(seq_canais[0]);  // Um único canal neste modo (canal 4 → sensor interno)
+    adc_set_round_robin(0);
+    adc_run(false);
+    adc_fifo_drain();
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv(ADC_CLOCK_HZ / parametros.taxa_sps - 1);
+
+    dma_temp_soma_bruta = 0;
+    dma_temp_amostras = 0;
+    dma_temp_bloco = parametros.bloco;
+    dma_temp_sniffer_ativo = true;
+
+    dma_sniffer_enable(canal, DMA_SNIFF_CTRL_CALC_VALUE_SUM, true);
+    dma_sniffer_set_data_accumulator(0);
+    dma_channel_configure(canal, cfg, &amostra_descartada, &adc_hw->fifo, parametros.bloco, true);
+
+    adc_run(true);
+}
+
+/**
+ * @brief Interrompe a aquisição e soma o bloco parcial em andamento.
+ *
+ * Tudo é feito com interrupções desabilitadas, de modo que um fim de
+ * bloco ainda não atendido pelo handler é contabilizado aqui a partir
+ * dos próprios registradores (contador restante e acumulador).
+ *
+ * @param canal Canal DMA observado pelo sniffer.
+ */
+static void parar_dma_temp(int canal) {
+    uint32_t status = save_and_disable_interrupts();
+
+    dma_temp_sniffer_ativo = false;
+    adc_run(false);
+    dma_channel_abort(canal);
+
+    uint32_t restantes = dma_hw->ch[canal].transfer_count;
+    dma_temp_soma_bruta += dma_sniffer_get_data_accumulator();
+    dma_temp_amostras += parametros.bloco - restantes;
+    dma_servico_descartar(1u << canal);   // Conclusão pendente já contabilizada
+
+    restore_interrupts(status);
+
+    dma_sniffer_disable();
+    adc_fifo_drain();
+
+    soma_bruta = dma_temp_soma_bruta;
+    total_amostras = dma_temp_amostras;
+}
+
+// No modo sniffer não há blocos a reduzir pela CPU nem fluxo decimado
+static void reduzir_blocos_prontos(void) {
+}
+
+#else
+
+/**
+ * @brief Inicia a aquisição contínua em ping-pong.
+ *
+ * O canal A é disparado imediatamente sobre a metade 0; o canal B
+ * fica armado sobre a metade 1 e é disparado pelo encadeamento quando
+ * A termina (e vice-versa). O ADC só é ligado depois de os dois
+ * canais estarem configurados.
+ *
+ * @param cfg_a Configuração do canal A (encadeado com B).
+ * @param canal_a Canal DMA A.
+ * @param cfg_b Configuração do canal B (encadeado com A).
+ * @param canal_b Canal DMA B.
+ */
+static void iniciar_dma_temp(dma_channel_config *cfg_a, int canal_a,
+                             dma_channel_config *cfg_b, int canal_b) {
+    adc_select_input(seq_canais[0]);  // Canal 4 → sensor interno
+    adc_set_round_robin(num_canais > 1 ? parametros.canais : 0);
+    adc_run(false);
+    adc_fifo_drain();
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv(ADC_CLOCK_HZ / parametros.taxa_sps - 1);
+
+    dma_temp_destino[0] = buffer_temp[0];
+    dma_temp_destino[1] = buffer_temp[1];
+    dma_temp_blocos_prontos = 0;
+    dma_temp_blocos_perdidos = 0;
+    blocos_janela = 0;
+    concluidos_inicio = dma_temp_blocos_concluidos;
+    captura_invalidar();   // O DMA volta a escrever na metade 0
+
+    dma_channel_configure(canal_b, cfg_b, buffer_temp[1], &adc_hw->fifo, parametros.bloco, false);
+    dma_channel_configure(canal_a, cfg_a, buffer_temp[0], &adc_hw->fifo, parametros.bloco, true);
+
+    adc_run(true);
+}
+
+/**
+ * @brief Interrompe o ping-pong e deixa os dois canais ociosos.
+ *
+ * Antes do abort, cada canal é encadeado a si mesmo: abortar um canal
+ * encadeado pode disparar o seu par (errata RP2040-E13). As interrupções
+ * geradas pelo abort são descartadas.
+ *
+ * @param canal_a Canal DMA A.
+ * @param canal_b Canal DMA B.
+ */
+static void parar_dma_temp(int canal_a, int canal_b) {
+    uint32_t mascara = (1u << canal_a) | (1u << canal_b);
+
+    adc_run(false);
+
+    hw_write_masked(&dma_hw->ch[canal_a].al1_ctrl,
+                    (uint32_t)canal_a << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB,
+                    DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS);
+    hw_write_masked(&dma_hw->ch[canal_b].al1_ctrl,
+                    (uint32_t)canal_b << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB,
+                    DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS);
+
+    dma_servico_habilitar_canal(canal_a, false);
+    dma_servico_habilitar_canal(canal_b, false);
+    dma_hw->abort = mascara;
+    while (dma_hw->abort & mascara) tight_loop_contents();
+    dma_servico_descartar(mascara);
+    dma_servico_habilitar_canal(canal_a, true);
+    dma_servico_habilitar_canal(canal_b, true);
+
+    adc_fifo_drain();
+}
+
+// Soma n amostras do round-robin no acumulador de cada canal, por passo
+static void somar_intercaladas(const uint16_t *amostras, uint32_t n) {
+    for (uint32_t k = 0; k < num_canais; k++) {
+        // Primeira amostra do trecho que pertence à posição k da sequência
+        uint32_t i = (k + num_canais - fase_rr) % num_canais;
+        uint32_t soma = 0, contagem = 0;
+        for (; i < n; i += num_canais) {
+            soma += amostras[i];
+            contagem++;
+        }
+        soma_canal[seq_canais[k]] += soma;
+        amostras_canal[seq_canais[k]] += contagem;
+    }
+    fase_rr = (fase_rr + n) % num_canais;
+}
+
+/**
+ * @brief Soma n amostras na média da janela e no boxcar de decimação.
+ *
+ * O laço interno percorre trechos que terminam numa fronteira de
+ * decimação, de modo que o custo por amostra continua sendo uma soma.
+ */
+static void somar_amostras(const uint16_t *amostras, uint32_t n) {
+    // Vários canais: separa por passo, sem decimação
+    if (num_canais > 1) {
+        somar_intercaladas(amostras, n);
+        return;
+    }
+
+    // Soma de um bloco cabe em 32 bits: 5.000 × 4.095
+    uint32_t soma_bloco = 0;
+
+    while (n) {
+        uint32_t trecho = parametros.decimacao - decim_contagem;
+        if (trecho > n) trecho = n;
+
+        uint32_t soma_trecho = 0;
+        for (uint32_t i = 0; i < trecho; i++) {
+            soma_trecho += amostras[i];
+        }
+        soma_bloco += soma_trecho;
+        decim_soma += soma_trecho;
+        decim_contagem += trecho;
+        amostras += trecho;
+        n -= trecho;
+
+        if (decim_contagem == parametros.decimacao) {
+            if (num_decimadas < TAREFA1_DECIMADAS_MAX) {
+                decimadas[num_decimadas++] = (uint16_t)(((uint64_t)decim_soma * 16u + decim_contagem / 2) / decim_contagem);
+            }
+            decim_soma = 0;
+            decim_contagem = 0;
+        }
+    }
+
+    soma_bruta += soma_bloco;
+}
+
+/**
+ * @brief Soma o bloco parcial em andamento ao fim da janela.
+ *
+ * Chamada depois de parar o DMA e reduzir os blocos completos: a metade
+ * 'proxima' é a do canal que estava transferindo (ou que terminou sem
+ * o IRQ ter sido atendido, caso em que o contador restante é zero).
+ */
+static void somar_bloco_parcial(void) {
+    int canal = proxima ? canal_b_ativo : canal_a_ativo;
+    uint32_t restantes = dma_hw->ch[canal].transfer_count;
+    uint32_t feitas = parametros.bloco - restantes;
+
+    somar_amostras(buffer_temp[proxima], feitas);
+    total_amostras += feitas;
+}
+
+/**
+ * @brief Soma as metades do ping-pong já entregues pelo DMA.
+ *
+ * As metades são consumidas na ordem em que o DMA as enche (0, 1, 0, ...).
+ * Com a captura ligada, a metade já somada é empacotada e entregue à USB;
+ * ela vale até o fim do bloco seguinte, quando o DMA volta a ela.
+ */
+static void reduzir_blocos_prontos(void) {
+    while (dma_temp_blocos_prontos & (1u << proxima)) {
+        uint8_t fase = (uint8_t)fase_rr;
+        somar_amostras(buffer_temp[proxima], parametros.bloco);
+        total_amostras += parametros.bloco;
+        blocos_janela++;
+        if (captura_ativa()) {
+            captura_entregar(buffer_temp[proxima], parametros.bloco, parametros.canais, fase,
+                             dma_temp_irq_us, concluidos_inicio + blocos_janela);
+        }
+
+        uint32_t status = save_and_disable_interrupts();
+        dma_temp_blocos_prontos &= ~(1u << proxima);
+        restore_interrupts(status);
+
+        proxima ^= 1u;
+    }
+}
+
+#endif
+
+static alarm_pool_t *pool_alarmes;     // NULL: pool padrão (núcleo 0)
+static bool fim_alarmado;              // Alarme do fim da janela agendado
+
+/**
+ * @brief Alarme de fim da estabilização: dispara o DMA e o ADC.
+ */
+static int64_t iniciar_apos_estabilizar(alarm_id_t id, void *dados) {
+    (void)id;
+    (void)dados;
+#if TAREFA1_USAR_SNIFFER
+    iniciar_dma_temp(cfg_a_ativa, canal_a_ativo);
+#else
+    iniciar_dma_temp(cfg_a_ativa, canal_a_ativo, cfg_b_ativa, canal_b_ativo);
+#endif
+    return 0;   // Não repete
+}
+
+/**
+ * @brief Alarme do fim da janela: acorda quem espera em tarefa1_aguardar().
+ */
+static int64_t acordar_fim_janela(alarm_id_t id, void *dados) {
+    (void)id;
+    (void)dados;
+    __sev();
+    return 0;
+}
+
+void tarefa1_iniciar(dma_channel_config *cfg_a, int canal_a,
+                     dma_channel_config *cfg_b, int canal_b) {
+    if (em_andamento) return;
+
+    if (agendamento_pendente) {
+        __dmb();   // 'agendados' completo antes da leitura
+        tarefa1_configurar(&agendados);
+        agendamento_pendente = false;
+    }
+
+    soma_bruta = 0;
+    total_amostras = 0;
+    proxima = 0;
+    num_decimadas = 0;
+    decim_soma = 0;
+    decim_contagem = 0;
+    fase_rr = 0;
+    num_canais = 0;
+    for (uint8_t c = 0; c < TAREFA1_CANAIS; c++) {
+        soma_canal[c] = 0;
+        amostras_canal[c] = 0;
+        if (parametros.canais & (1u << c)) seq_canais[num_canais++] = c;
+    }
+    canal_a_ativo = canal_a;
+    canal_b_ativo = canal_b;
+    concluida = false;
+    em_andamento = true;
+
+    cfg_a_ativa = cfg_a;
+    cfg_b_ativa = cfg_b;
+
+    // Um ciclo atrasado encurta a janela em vez de atrasar os seguintes
+    duracao_janela_us = parametros.duracao_us;
+    if (orcamento_us < ESTABILIZACAO_SENSOR_US + duracao_janela_us) {
+        duracao_janela_us = orcamento_us > ESTABILIZACAO_SENSOR_US + TAREFA1_DURACAO_MIN_US
+                          ? orcamento_us - ESTABILIZACAO_SENSOR_US : TAREFA1_DURACAO_MIN_US;
+        janelas_encurtadas++;
+    }
+    orcamento_us = UINT32_MAX;
+
+    // A janela começa depois da estabilização do sensor
+    ligar_sensor();
+    fim_janela = make_timeout_time_us(ESTABILIZACAO_SENSOR_US + duracao_janela_us);
+    alarm_pool_t *pool = pool_alarmes ? pool_alarmes : alarm_pool_get_default();
+    if (alarm_pool_add_alarm_in_us(pool, ESTABILIZACAO_SENSOR_US, iniciar_apos_estabilizar, NULL, true) < 0) {
+        // Sem alarme livre: espera a estabilização aqui (200 µs), para a
+        // janela não fechar sem amostras e com média 0
+        busy_wait_us_32(ESTABILIZACAO_SENSOR_US);
+        iniciar_apos_estabilizar(0, NULL);
+    }
+    // Com taxa baixa e bloco grande, o próximo bloco do DMA pode vir
+    // segundos depois do fim da janela
+    fim_alarmado = alarm_pool_add_alarm_at(pool, fim_janela, acordar_fim_janela, NULL, true) >= 0;
+}
+
+void tarefa1_aguardar(void) {
+    // O evento do __sev() fica registrado: não se perde entre a consulta
+    // a tarefa1_pronta() e o __wfe(). Sem o alarme, não dorme.
+    if (fim_alarmado) __wfe();
+    else tight_loop_contents();
+}
+
+void tarefa1_usar_alarmes(alarm_pool_t *pool) {
+    pool_alarmes = pool;
+}
+
+void tarefa1_definir_orcamento(uint32_t orcamento) {
+    orcamento_us = orcamento;
+}
+
+uint32_t tarefa1_janelas_encurtadas(void) {
+    return janelas_encurtadas;
+}
+
+bool tarefa1_pronta(void) {
+    if (!em_andamento) return concluida;
+
+    // Latência entre o fim de bloco no IRQ e esta consulta perceber o bloco
+    if (dma_temp_done) {
+        dma_temp_done = false;
+        estatistica_registrar(&estat_latencia_dma, time_us_32() - dma_temp_irq_us);
+    }
+
+    reduzir_blocos_prontos();
+    if (!time_reached(fim_janela)) return false;
+
+    // Blocos completos entregues durante a parada e o bloco parcial também contam
+#if TAREFA1_USAR_SNIFFER
+    parar_dma_temp(canal_a_ativo);
+    resultado.blocos_perdidos = 0;
+#else
+    parar_dma_temp(canal_a_ativo, canal_b_ativo);
+    reduzir_blocos_prontos();
+    somar_bloco_parcial();
+    resultado.blocos_perdidos = dma_temp_blocos_perdidos;
+#endif
+    desligar_sensor();
+
+    // Com um canal a redução acumula direto na soma total
+    if (num_canais == 1) {
+        soma_canal[seq_canais[0]] = soma_bruta;
+        amostras_canal[seq_canais[0]] = total_amostras;
+    }
+
+    uint8_t p = (parametros.canais & (1u << TAREFA1_CANAL_SENSOR)) ? TAREFA1_CANAL_SENSOR : seq_canais[0];
+    resultado.canais = parametros.canais;
+    resultado.canal_principal = p;
+    for (uint8_t c = 0; c < TAREFA1_CANAIS; c++) {
+        resultado.amostras_canal[c] = amostras_canal[c];
+        resultado.centi_canal[c] = calibracao_canal_para_centi(c, soma_canal[c], amostras_canal[c]);
+    }
+
+    resultado.amostras = amostras_canal[p];
+    resultado.duracao_us = duracao_janela_us;
+    resultado.soma_bruta = soma_canal[p];
+    resultado.media_bruta_q4 = amostras_canal[p] ? (uint16_t)((soma_canal[p] * 16 + amostras_canal[p] / 2) / amostras_canal[p]) : 0;
+    resultado.media_centi = resultado.centi_canal[p];
+
+    em_andamento = false;
+    concluida = true;
+    return true;
+}
+
+bool tarefa1_em_andamento(void) {
+    return em_andamento;
+}
+
+const tarefa1_resultado_t *tarefa1_resultado(void) {
+    return &resultado;
+}
+
+bool tarefa1_configurar(const tarefa1_parametros_t *p) {
+    if (em_andamento) return false;
+
+    tarefa1_parametros_t n = *p;
+    if (n.taxa_sps > ADC_TAXA_MAX_SPS) n.taxa_sps = ADC_TAXA_MAX_SPS;
+    if (n.taxa_sps < ADC_TAXA_MIN_SPS) n.taxa_sps = ADC_TAXA_MIN_SPS;
+    if (n.duracao_us > TAREFA1_DURACAO_MAX_US) n.duracao_us = TAREFA1_DURACAO_MAX_US;
+    if (n.duracao_us < TAREFA1_DURACAO_MIN_US) n.duracao_us = TAREFA1_DURACAO_MIN_US;
+    if (n.bloco > TAREFA1_BLOCO_MAX) n.bloco = TAREFA1_BLOCO_MAX;
+    if (n.bloco == 0) n.bloco = 1;
+    if (n.decimacao == 0) n.decimacao = 1;
+
+    n.canais &= (1u << TAREFA1_CANAIS) - 1;
+    if (n.canais == 0) n.canais = 1u << TAREFA1_CANAL_SENSOR;
+#if TAREFA1_USAR_SNIFFER
+    // Um só acumulador no sniffer: sensor interno se pedido, senão o menor canal
+    if (n.canais & (1u << TAREFA1_CANAL_SENSOR)) n.canais = 1u << TAREFA1_CANAL_SENSOR;
+    else n.canais &= -n.canais;
+#endif
+    for (uint8_t c = 0; c < TAREFA1_CANAL_SENSOR; c++) {
+        if (n.canais & (1u << c)) adc_gpio_init(26 + c);
+    }
+
+    parametros = n;
+    return true;
+}
+
+bool tarefa1_agendar_configuracao(const tarefa1_parametros_t *p) {
+    if (agendamento_pendente) return false;
+    agendados = *p;
+    __dmb();   // Publica os parâmetros antes do sinalizador
+    agendamento_pendente = true;
+    return true;
+}
+
+const tarefa1_parametros_t *tarefa1_parametros(void) {
+    return &parametros;
+}
+
+uint32_t tarefa1_decimadas(const uint16_t **amostras) {
+    *amostras = decimadas;
+    return em_andamento ? 0 : num_decimadas;
+}
+
+/**
+ * @brief Executa a Tarefa 1 do executor cíclico: coleta de temperatura por 0,5s.
+ *
+ * Versão bloqueante, construída sobre a interface assíncrona.
+ *
+ * @param cfg_a Configuração do canal DMA A (ou do sniffer).
+ * @param canal_a Número do canal DMA A (ou do sniffer).
+ * @param cfg_b Configuração do canal DMA B (não usado com sniffer).
+ * @param canal_b Número do canal DMA B (não usado com sniffer).
+ * @return float Temperatura média calculada ao final do intervalo.
+ */
+float tarefa1_obter_media_temp(dma_channel_config *cfg_a, int canal_a,
+                               dma_channel_config *cfg_b, int canal_b) {
+    tarefa1_iniciar(cfg_a, canal_a, cfg_b, canal_b);
+    while (!tarefa1_pronta()) tarefa1_aguardar();
+    return resultado.media_centi / 100.0f;
+}
+
+/**
+ * @brief Tempo total com o ADC e o sensor ligados, para o ciclo de trabalho.
+ */
+uint64_t tarefa1_tempo_sensor_ligado_us(void) {
+    uint64_t total = sensor_tempo_ligado_us;
+    if (em_andamento) total += absolute_time_diff_us(sensor_ligado_em, get_absolute_time());
+    return total;
+}
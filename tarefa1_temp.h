@@ -1,8 +1,151 @@
-#ifndef TAREFA1_TEMP_H
-#define TAREFA1_TEMP_H
-
-#include "hardware/dma.h"
-
-float tarefa1_obter_media_temp(dma_channel_config* cfg, int dma_chan);
-
+#ifndef TAREFA1_TEMP_H
+#define TAREFA1_TEMP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/time.h"
+#include "hardware/dma.h"
+#include "setup.h"          // TAREFA1_USAR_SNIFFER
+
+#define TAREFA1_CANAIS        5          // Entradas do ADC: 0-3 (GPIO 26-29), 4 sensor interno
+#define TAREFA1_CANAL_SENSOR  4
+
+// Resultado de uma janela de aquisição. Os campos de média referem-se
+// ao canal principal: o sensor interno se amostrado, senão o menor canal.
+typedef struct {
+    int32_t media_centi;       // Temperatura média calibrada (centésimos de °C)
+    uint32_t amostras;         // Amostras efetivamente somadas
+    uint16_t media_bruta_q4;   // Média do código do ADC × 16 (antes da calibração)
+    uint64_t soma_bruta;       // Soma dos códigos brutos da janela
+    uint32_t blocos_perdidos;  // Metades sobrescritas antes de serem somadas
+    uint32_t duracao_us;       // Duração efetiva da janela (encurtada pelo orçamento)
+    uint8_t canais;            // Máscara dos canais amostrados
+    uint8_t canal_principal;
+    int32_t centi_canal[TAREFA1_CANAIS];      // Temperatura de cada canal amostrado (ou CALIBRACAO_INVALIDA)
+    uint32_t amostras_canal[TAREFA1_CANAIS];
+} tarefa1_resultado_t;
+
+#define TAREFA1_DURACAO_MAX_US 900000   // Cabe no ciclo de 1 s do executor
+#define TAREFA1_DURACAO_MIN_US 1000
+#if TAREFA1_USAR_SNIFFER
+#define TAREFA1_BLOCO_MAX      0xFFFF   // Transferências entre interrupções do sniffer
+#else
+#define TAREFA1_BLOCO_MAX      5000     // Tamanho de cada metade do ping-pong
+#endif
+#define TAREFA1_JANELA_BOOT_US 20000    // Orçamento da primeira janela: leitura logo após o boot
+#define TAREFA1_DECIMADAS_MAX  256      // Saídas do boxcar guardadas por janela
+
+// Parâmetros de aquisição, alteráveis entre janelas
+typedef struct {
+    uint32_t taxa_sps;         // Taxa do ADC (1.000 a 500.000 amostras/s)
+    uint32_t duracao_us;       // Duração da janela
+    uint16_t bloco;            // Amostras por bloco do DMA (ping-pong: até 5.000)
+    uint16_t decimacao;        // Amostras por saída do boxcar (ping-pong, um canal)
+    uint8_t canais;            // Máscara de entradas em round-robin (bit i = ADCi)
+} tarefa1_parametros_t;
+
+/**
+ * @brief Dispara uma janela de aquisição e retorna imediatamente.
+ *
+ * Ignorada se já houver uma janela em andamento.
+ */
+void tarefa1_iniciar(dma_channel_config *cfg_a, int canal_a,
+                     dma_channel_config *cfg_b, int canal_b);
+
+/**
+ * @brief Escolhe o pool dos alarmes da janela.
+ *
+ * Os callbacks disparam o DMA e mexem no estado da aquisição, então o
+ * pool deve ser de um alarme habilitado no núcleo que chama
+ * tarefa1_iniciar() e tarefa1_pronta(). NULL (inicial): pool padrão,
+ * atendido pelo núcleo 0.
+ */
+void tarefa1_usar_alarmes(alarm_pool_t *pool);
+
+/**
+ * @brief Limita o tempo da próxima janela ao orçamento do ciclo.
+ *
+ * Vale só para a próxima chamada de tarefa1_iniciar(): o tempo entre
+ * o disparo e o fim da janela (estabilização incluída) não passa de
+ * 'orcamento_us', com a janela nunca abaixo de TAREFA1_DURACAO_MIN_US.
+ * Abaixo da duração configurada, a janela é encurtada e contada; o
+ * número de amostras em tarefa1_resultado() diz quanto a média vale.
+ */
+void tarefa1_definir_orcamento(uint32_t orcamento_us);
+
+/**
+ * @brief Janelas encurtadas pelo orçamento desde o início.
+ */
+uint32_t tarefa1_janelas_encurtadas(void);
+
+/**
+ * @brief Avança a aquisição; deve ser chamada pelo laço principal.
+ *
+ * Soma as metades já entregues pelo DMA e, terminada a janela,
+ * encerra a captura e calcula o resultado.
+ *
+ * @return true quando o resultado da última janela está disponível.
+ */
+bool tarefa1_pronta(void);
+
+/**
+ * @brief Dorme até o próximo bloco do DMA ou o fim da janela.
+ *
+ * Para laços que esperam tarefa1_pronta(): o alarme do fim da janela
+ * (no pool de tarefa1_usar_alarmes()) acorda o núcleo mesmo sem blocos.
+ * Pode retornar antes, com eventos de outras fontes.
+ */
+void tarefa1_aguardar(void);
+
+/**
+ * @brief Indica se há uma janela de aquisição em andamento.
+ */
+bool tarefa1_em_andamento(void);
+
+/**
+ * @brief Resultado da última janela concluída.
+ */
+const tarefa1_resultado_t *tarefa1_resultado(void);
+
+/**
+ * @brief Altera os parâmetros de aquisição (valores fora da faixa são limitados).
+ *
+ * @return false se houver uma janela em andamento; nada é alterado.
+ */
+bool tarefa1_configurar(const tarefa1_parametros_t *p);
+
+/**
+ * @brief Agenda parâmetros para a próxima janela, de qualquer núcleo.
+ *
+ * São aplicados por tarefa1_configurar() no início do próximo
+ * tarefa1_iniciar(), no núcleo que roda a aquisição; até lá
+ * tarefa1_parametros() continua mostrando os anteriores.
+ *
+ * @return false se um agendamento anterior ainda não foi aplicado.
+ */
+bool tarefa1_agendar_configuracao(const tarefa1_parametros_t *p);
+
+/**
+ * @brief Parâmetros de aquisição em uso.
+ */
+const tarefa1_parametros_t *tarefa1_parametros(void);
+
+/**
+ * @brief Fluxo decimado (médias de 'decimacao' amostras, código do ADC × 16)
+ *        da última janela concluída; vazio no modo sniffer.
+ *
+ * @return Número de saídas (0 durante uma janela).
+ */
+uint32_t tarefa1_decimadas(const uint16_t **amostras);
+
+/**
+ * @brief Tempo acumulado com o ADC e o sensor ligados (µs).
+ *
+ * Fora das janelas de aquisição ambos ficam desligados.
+ */
+uint64_t tarefa1_tempo_sensor_ligado_us(void);
+
+float tarefa1_obter_media_temp(dma_channel_config *cfg_a, int canal_a,
+                               dma_channel_config *cfg_b, int canal_b);
+
 #endif
\ No newline at end of file
@@ -1,58 +1,217 @@
-/**
- * ------------------------------------------------------------
- *  Arquivo: tarefa2_display.c
- *  Projeto: TempCycleDMA
- * ------------------------------------------------------------
- *  Descrição:
- *      Tarefa 2 corrigida: exibe no display OLED duas linhas:
- *
- *         TEMP: 32.4 C
- *         TEND: ESTAVEL
- *
- *      Ambas centralizadas horizontalmente, usando fonte padrão.
- *
- *  
- *  Data: 12/05/2025
- * ------------------------------------------------------------
- */
-
-#include <stdio.h>
-#include <string.h>
-#include "ssd1306.h"
-#include "display_utils.h"
-#include "tarefa2_display.h"
-#include "tarefa3_tendencia.h"
-
-extern uint8_t ssd[];
-extern struct render_area area;
-
-void tarefa2_exibir_oled(float temperatura, tendencia_t tendencia) {
-    ssd1306_clear_display(ssd);
-    render_on_display(ssd, &area);  // Garante que a limpeza seja visível
-    sleep_ms(20);                   // Pequeno delay opcional
-
-    char* linha1 = "Temperatura";
-    char* linha2 = "Media";
-    char linha3[30];
-
-    snprintf(linha3, sizeof(linha3), "TEMP: %s", tendencia_para_texto(tendencia));
-
-    // Fonte padrão: 6 px por caractere, altura: 8 px
-    int x1 = (128 - strlen(linha1) * 6) / 2;
-    int x2 = (128 - strlen(linha2) * 6) / 2;
-    int x3 = (128 - strlen(linha3) * 6) / 2;
-
-    // Y = linha × altura da fonte (8 px padrão)
-    ssd1306_draw_string(ssd, x1, 0, linha1);    // Linha 0 (Y=0)
-    // Linha 1 = em branco (Y=8)
-    ssd1306_draw_string(ssd, x2, 16, linha2);   // Linha 2 (Y=16)
-    // Linha 3 = em branco (Y=24)
-
-    // Fonte grande começa abaixo: Y=32 px
-    mostrar_valor_grande(ssd, temperatura, 32);
-
-    ssd1306_draw_string(ssd, 0, 56, linha3);  // Y = 32 
-
-    render_on_display(ssd, &area);
-}
-
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: tarefa2_display.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Tarefa 2 corrigida: exibe no display OLED duas linhas:
+ *
+ *         TEMP: 32.4 C
+ *         TEND: ESTAVEL
+ *
+ *      Ambas centralizadas horizontalmente, usando fonte padrão.
+ *
+ *      O quadro tem duas camadas. A estática (rótulos das
+ *      páginas 0 a 3) é desenhada uma vez em 'fundo' e copiada
+ *      para ssd[] no primeiro quadro ou quando o layout muda.
+ *      A cada quadro só as páginas dinâmicas (valor grande e
+ *      tendência, páginas 4 a 7) são restauradas do fundo e
+ *      redesenhadas, e nem isso se valor e tendência não
+ *      mudaram.
+ *
+ *      O valor é formatado em ponto fixo (formato.h) e comparado
+ *      com o último texto desenhado: fora a troca de tendência,
+ *      cujo texto cobre o pé dos glifos e pede as páginas
+ *      dinâmicas inteiras, só os glifos que mudaram são
+ *      redesenhados.
+ *
+ *      Com TAREFA2_GRAFICO, o título dá lugar a um gráfico de
+ *      varredura nas páginas 0 e 1 (16 px de altura, uma coluna
+ *      por ciclo). As leituras ficam em um anel de 128 colunas
+ *      e a posição de escrita avança sobre ele, com uma coluna
+ *      apagada à frente como cursor: por ciclo, só essas duas
+ *      colunas mudam, e o flush envia 2 bytes por página. O
+ *      controlador não tem deslocamento horizontal de início de
+ *      coluna, e o scroll por hardware (0x26/0x2E) é contínuo
+ *      e exige reescrever a RAM ao parar; a varredura dá o
+ *      mesmo tráfego sem dessincronizar a sombra do flush.
+ *
+ *      O quadro é montado apenas em RAM e enviado com
+ *      ssd1306_flush_async(), que transmite somente as colunas
+ *      que mudaram desde o quadro anterior, via DMA, sem ocupar
+ *      a CPU durante a transferência I2C.
+ *
+ *
+ *  Data: 12/05/2025
+ * ------------------------------------------------------------
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+#include "ssd1306.h"
+#include "display_utils.h"
+#include "tarefa2_display.h"
+#include "tarefa3_tendencia.h"
+
+#define PAGINA_DINAMICA  4   // Primeira página da camada dinâmica (Y=32)
+#define OFFSET_DINAMICO  (PAGINA_DINAMICA * ssd1306_width)
+
+#define GRAFICO_PAGINAS  2                     // Páginas 0 e 1
+#define GRAFICO_ALTURA   (GRAFICO_PAGINAS * 8)
+#define GRAFICO_FAIXA_MIN 50                   // Menor faixa da escala (0,5 °C)
+#define GRAFICO_VAZIO    INT32_MIN
+
+extern uint8_t *const ssd;  // Precedido pelo byte de controle (setup.c)
+
+static uint8_t fundo[ssd1306_buffer_length];   // Camada estática
+static bool fundo_no_quadro = false;           // ssd[] contém a camada estática
+static valor_grande_t valor_anterior;         // Texto grande que está em ssd[]
+static tendencia_t tendencia_anterior;
+
+#if TAREFA2_GRAFICO
+static int32_t grafico[ssd1306_width];         // Leitura de cada coluna (centésimos)
+static bool grafico_iniciado = false;
+static int grafico_coluna = 0;                 // Próxima coluna (cursor)
+static int32_t escala_min, escala_max;
+#endif
+
+// Fonte padrão: 6 px por caractere, altura: 8 px
+static int centralizar(const char *texto) {
+    return (ssd1306_width - (int)strlen(texto) * 6) / 2;
+}
+
+static void desenhar_fundo(void) {
+    static const char linha1[] = "Temperatura";
+    static const char linha2[] = "Media";
+
+    memset(fundo, 0, sizeof(fundo));
+    // Y = linha × altura da fonte (8 px padrão)
+#if TAREFA2_GRAFICO
+    (void)linha1;                                                  // Linhas 0 e 1: gráfico
+#else
+    ssd1306_draw_string(fundo, centralizar(linha1), 0, linha1);    // Linha 0 (Y=0)
+    // Linha 1 = em branco (Y=8)
+#endif
+    ssd1306_draw_string(fundo, centralizar(linha2), 16, linha2);   // Linha 2 (Y=16)
+    // Linha 3 = em branco (Y=24)
+}
+
+void tarefa2_invalidar_fundo(void) {
+    fundo_no_quadro = false;
+}
+
+#if TAREFA2_GRAFICO
+// Linha do gráfico (0 = topo) de uma leitura, limitada à área
+static int grafico_y(int32_t centi) {
+    int32_t y = (GRAFICO_ALTURA - 1) -
+                (centi - escala_min) * (GRAFICO_ALTURA - 1) / (escala_max - escala_min);
+    if (y < 0) y = 0;
+    if (y > GRAFICO_ALTURA - 1) y = GRAFICO_ALTURA - 1;
+    return (int)y;
+}
+
+// Redesenha a coluna: segmento vertical da leitura anterior até a atual
+static void grafico_desenhar_coluna(int c) {
+    uint32_t bits = 0;
+    if (c != grafico_coluna && grafico[c] != GRAFICO_VAZIO) {
+        int y = grafico_y(grafico[c]);
+        int anterior = (c + ssd1306_width - 1) % ssd1306_width;
+        int y0 = (anterior != grafico_coluna && grafico[anterior] != GRAFICO_VAZIO)
+               ? grafico_y(grafico[anterior]) : y;
+        int ini = y0 < y ? y0 : y, fim = y0 < y ? y : y0;
+        for (int k = ini; k <= fim; k++) bits |= 1u << k;
+    }
+    for (int page = 0; page < GRAFICO_PAGINAS; page++) {
+        ssd[page * ssd1306_width + c] = (uint8_t)(bits >> (page * 8));
+        ssd1306_mark_dirty(page, c, c);
+    }
+}
+
+static void grafico_desenhar_tudo(void) {
+    for (int c = 0; c < ssd1306_width; c++) grafico_desenhar_coluna(c);
+}
+
+// Escala: extremos da janela da Tarefa 3 com 1/8 de margem, faixa mínima fixa.
+// 'sentido' (+1 subindo, -1 caindo) reserva mais uma faixa para o lado em
+// que a leitura saiu, para uma rampa não trocar a escala a cada ciclo.
+static void grafico_definir_escala(int32_t minimo, int32_t maximo, int sentido) {
+    int32_t faixa = maximo - minimo;
+    if (faixa < GRAFICO_FAIXA_MIN) {
+        minimo -= (GRAFICO_FAIXA_MIN - faixa) / 2;
+        faixa = GRAFICO_FAIXA_MIN;
+    }
+    escala_min = minimo - faixa / 8 - (sentido < 0 ? faixa : 0);
+    escala_max = minimo + faixa + faixa / 8 + (sentido > 0 ? faixa : 0);
+}
+#endif
+
+void tarefa2_registrar_leitura(int32_t centi, int32_t minimo_centi, int32_t maximo_centi) {
+#if TAREFA2_GRAFICO
+    if (!grafico_iniciado) {
+        for (int c = 0; c < ssd1306_width; c++) grafico[c] = GRAFICO_VAZIO;
+        grafico_definir_escala(minimo_centi, maximo_centi, 0);
+        grafico_iniciado = true;
+    }
+
+    int c = grafico_coluna;
+    grafico[c] = centi;
+    grafico_coluna = (c + 1) % ssd1306_width;
+
+    // Fora da escala, ou a janela ocupando menos de 1/4 dela: nova escala
+    int sentido = centi > escala_max ? 1 : centi < escala_min ? -1 : 0;
+    bool estreita = (escala_max - escala_min) > GRAFICO_FAIXA_MIN * 2 &&
+                    (maximo_centi - minimo_centi) * 4 < (escala_max - escala_min);
+    if (sentido || estreita) {
+        grafico_definir_escala(minimo_centi, maximo_centi, sentido);
+        grafico_desenhar_tudo();   // Raro: as duas páginas inteiras
+        return;
+    }
+    grafico_desenhar_coluna(c);
+    grafico_desenhar_coluna(grafico_coluna);   // Cursor apagado à frente
+#else
+    (void)centi; (void)minimo_centi; (void)maximo_centi;
+#endif
+}
+
+void tarefa2_exibir_oled(float temperatura, tendencia_t tendencia) {
+    int32_t decimos = (int32_t)lroundf(temperatura * 10.0f);   // Resolução exibida
+    bool redesenhar = tendencia != tendencia_anterior;
+
+    if (!fundo_no_quadro) {
+        desenhar_fundo();
+        memcpy(ssd, fundo, OFFSET_DINAMICO);
+        for (int page = 0; page < PAGINA_DINAMICA; page++) {
+            ssd1306_mark_dirty(page, 0, ssd1306_width - 1);
+        }
+#if TAREFA2_GRAFICO
+        if (grafico_iniciado) grafico_desenhar_tudo();   // O fundo cobriu o gráfico
+#endif
+        fundo_no_quadro = true;
+        redesenhar = true;
+    }
+
+    if (redesenhar) {
+        // Restaura as páginas dinâmicas; o flush compara com o painel e só
+        // envia as colunas que o novo desenho de fato alterou
+        memcpy(ssd + OFFSET_DINAMICO, fundo + OFFSET_DINAMICO, ssd1306_buffer_length - OFFSET_DINAMICO);
+        for (int page = PAGINA_DINAMICA; page < ssd1306_n_pages; page++) {
+            ssd1306_mark_dirty(page, 0, ssd1306_width - 1);
+        }
+        valor_anterior.texto[0] = '\0';
+        tendencia_anterior = tendencia;
+    }
+
+    // Fonte grande começa abaixo: Y=32 px
+    if (mostrar_valor_grande(ssd, &valor_anterior, decimos * 10, 32) == 0 && !redesenhar) {
+        ssd1306_flush_async(ssd);   // Conclui um envio adiado com o DMA ocupado
+        return;
+    }
+
+    // O texto cobre a última página dos glifos: vai por cima de novo
+
+    ssd1306_draw_string(ssd, 0, 56, "TEMP: ");
+    ssd1306_draw_string(ssd, 6 * 8, 56, tendencia_para_texto(tendencia));
+
+    ssd1306_flush_async(ssd);       // Envia só o que mudou, em segundo plano
+}
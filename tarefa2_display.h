@@ -1,29 +1,62 @@
-/**
- * ------------------------------------------------------------
- *  Arquivo: tarefa2_display.h
- *  Projeto: TempCycleDMA
- * ------------------------------------------------------------
- *  Descrição:
- *      Interface da Tarefa 2: exibição no display OLED.
- *      Exibe a temperatura média em fonte grande e a
- *      tendência térmica detectada pela Tarefa 3.
- *
- *  
- *  Data: 12/05/2025
- * ------------------------------------------------------------
- */
-
-#ifndef TAREFA2_DISPLAY_H
-#define TAREFA2_DISPLAY_H
-
-#include "tarefa3_tendencia.h"  // necessário para tipo tendencia_t
-
-/**
- * @brief Exibe no OLED a temperatura média e a tendência térmica.
- *
- * @param temperatura Valor da temperatura média atual
- * @param tendencia Resultado da análise de tendência (subindo, caindo, estável)
- */
-void tarefa2_exibir_oled(float temperatura, tendencia_t tendencia);
-
-#endif  // TAREFA2_DISPLAY_H
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: tarefa2_display.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Interface da Tarefa 2: exibição no display OLED.
+ *      Exibe a temperatura média em fonte grande e a
+ *      tendência térmica detectada pela Tarefa 3.
+ *      Os rótulos são desenhados uma só vez (camada estática).
+ *
+ *      Com TAREFA2_GRAFICO, as páginas 0 e 1 (no lugar do
+ *      título) mostram as últimas leituras em um gráfico de
+ *      varredura: a cada ciclo só a coluna nova e o cursor à
+ *      frente dela são desenhados e enviados.
+ *
+ *  
+ *  Data: 12/05/2025
+ * ------------------------------------------------------------
+ */
+
+#ifndef TAREFA2_DISPLAY_H
+#define TAREFA2_DISPLAY_H
+
+#include <stdint.h>
+#include "tarefa3_tendencia.h"  // necessário para tipo tendencia_t
+
+// Gráfico das últimas leituras no topo do OLED (0 → título "Temperatura")
+#ifndef TAREFA2_GRAFICO
+#define TAREFA2_GRAFICO 1
+#endif
+
+/**
+ * @brief Exibe no OLED a temperatura média e a tendência térmica.
+ *
+ * @param temperatura Valor da temperatura média atual
+ * @param tendencia Resultado da análise de tendência (subindo, caindo, estável)
+ */
+void tarefa2_exibir_oled(float temperatura, tendencia_t tendencia);
+
+/**
+ * @brief Faz o próximo quadro redesenhar a camada estática.
+ *
+ * Chamar quando o layout muda ou quando outro código escreveu em ssd[].
+ */
+void tarefa2_invalidar_fundo(void);
+
+/**
+ * @brief Acrescenta a leitura do ciclo ao gráfico; chamar uma vez por ciclo.
+ *
+ * Só desenha em ssd[]; o envio fica com o próximo quadro da Tarefa 2.
+ * A escala vem dos extremos da janela da Tarefa 3 e só muda (com o
+ * gráfico inteiro redesenhado) quando a leitura sai dela ou quando
+ * a janela fica muito mais estreita que a escala.
+ *
+ * @param centi Leitura (centésimos de °C)
+ * @param minimo_centi Menor leitura na janela da Tarefa 3
+ * @param maximo_centi Maior leitura na janela da Tarefa 3
+ */
+void tarefa2_registrar_leitura(int32_t centi, int32_t minimo_centi, int32_t maximo_centi);
+
+#endif  // TAREFA2_DISPLAY_H
@@ -1,66 +1,225 @@
-/**
- * ------------------------------------------------------------
- *  Arquivo: tarefa3_tendencia.c
- *  Projeto: TempCycleDMA
- * ------------------------------------------------------------
- *  Descrição:
- *      Este módulo implementa a Tarefa 3 do executor cíclico:
- *      a análise de tendência da temperatura.
- *      
- *      A função compara a temperatura atual com a anterior
- *      e classifica como:
- *          - TENDÊNCIA_SUBINDO
- *          - TENDÊNCIA_CAINDO
- *          - TENDÊNCIA_ESTÁVEL
- *
- *      A tendência é detectada com base em um limiar mínimo
- *      de variação (±0.05°C) e pode ser exibida no terminal
- *      ou no display OLED.
- * 
- *  Funcionalidades:
- *      - Armazena a última temperatura registrada
- *      - Retorna enum `tendencia_t` representando o estado
- *      - Oferece função auxiliar para converter enum em string
- *
- *  Relacionamento:
- *      - Usado no `main.c` para complementar a exibição
- *      - Opcionalmente integrado à Tarefa 2 para mostrar no OLED
- *
- *  
- *  Data: 12/05/2025
- * ------------------------------------------------------------
- */
-
-#include "tarefa3_tendencia.h"
-
-static float temperatura_anterior = 0.0f;
-static int primeiro_ciclo = 1;
-
-tendencia_t tarefa3_analisa_tendencia(float atual) {
-    tendencia_t resultado;
-
-    if (primeiro_ciclo) {
-        resultado = TENDENCIA_ESTÁVEL;
-        primeiro_ciclo = 0;
-    } else {
-        float delta = atual - temperatura_anterior;
-
-        if (delta > 0.01f)
-            resultado = TENDENCIA_SUBINDO;
-        else if (delta < -0.01f)
-            resultado = TENDENCIA_CAINDO;
-        else
-            resultado = TENDENCIA_ESTÁVEL;
-    }
-
-    temperatura_anterior = atual;
-    return resultado;
-}
-
-const char* tendencia_para_texto(tendencia_t t) {
-    switch (t) {
-        case TENDENCIA_SUBINDO:  return "SUBINDO";
-        case TENDENCIA_CAINDO:   return "CAINDO";
-        default:                 return "ESTAVEL";
-    }
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: tarefa3_tendencia.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Este módulo implementa a Tarefa 3 do executor cíclico:
+ *      a análise de tendência da temperatura.
+ *      
+ *      Cada leitura entra em um histórico circular de
+ *      TENDENCIA_JANELA posições, e as somas Σt, Σy, Σty e Σy²
+ *      são mantidas incrementalmente em inteiros (centésimos
+ *      de °C), de modo que cada atualização calcula em O(1):
+ *          - a inclinação por mínimos quadrados na janela
+ *          - a variância das leituras na janela
+ *          - uma média móvel exponencial (EMA)
+ *          - o mínimo e o máximo da janela, por duas filas
+ *            monótonas (O(1) amortizado), usados na escala do
+ *            gráfico do OLED
+ *
+ *      A classificação usa a inclinação com histerese: para
+ *      entrar em SUBINDO/CAINDO é preciso passar de
+ *      'limiar_entrada', e para voltar a ESTÁVEL é preciso cair
+ *      abaixo de 'limiar_saida'. Assim o ruído de uma leitura não
+ *      troca a tendência a cada ciclo, e o OLED e os LEDs (que
+ *      só retransmitem quando algo muda) ficam em repouso. Os
+ *      limiares podem ser trocados em execução
+ *      (tarefa3_definir_limiares, shell de ajustes).
+ *
+ *      Cada canal do ADC tem o seu próprio estado de
+ *      tendência (tarefa3_atualizar_canal); a interface
+ *      original usa o estado do canal 4 (sensor interno).
+ *
+ *  Funcionalidades:
+ *      - Retorna enum `tendencia_t` representando o estado
+ *      - Resultado completo em `tarefa3_resultado_t`
+ *      - Oferece função auxiliar para converter enum em string
+ *
+ *  Relacionamento:
+ *      - Usado no `main.c` para complementar a exibição
+ *      - Opcionalmente integrado à Tarefa 2 para mostrar no OLED
+ *
+ *  
+ *  Data: 12/05/2025
+ * ------------------------------------------------------------
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include "tarefa3_tendencia.h"
+#include "calibracao.h"
+
+// Limiares padrão da inclinação, em °C por leitura (1 leitura por ciclo de 1 s)
+#define LIMIAR_ENTRADA_PADRAO 0.005f   // 0,3 °C/min
+#define LIMIAR_SAIDA_PADRAO   0.002f   // 0,12 °C/min
+#define AMOSTRAS_MINIMAS 4      // Abaixo disso a tendência é ESTÁVEL
+#define EMA_DESLOCAMENTO 3      // alfa = 1/8
+
+// Sequências das candidatas a extremo da janela, da mais antiga para a mais
+// nova; os valores correspondentes são monótonos
+typedef struct {
+    uint32_t seq[TENDENCIA_JANELA];
+    uint8_t inicio;
+    uint8_t n;
+} fila_monotona_t;
+
+// Histórico circular e somas com t relativo à leitura mais antiga (t = 0)
+typedef struct {
+    int32_t historico[TENDENCIA_JANELA];
+    uint32_t mais_antiga;
+    uint32_t n;
+    int64_t soma_y;
+    int64_t soma_yy;
+    int64_t soma_ty;
+    float ema;
+    uint32_t sequencia;                  // Leituras recebidas; a k-ésima fica em historico[k % JANELA]
+    fila_monotona_t fila_min;
+    fila_monotona_t fila_max;
+    tarefa3_resultado_t resultado;
+} estado_tendencia_t;
+
+static estado_tendencia_t estados[TENDENCIA_CANAIS];   // Zerados: tendência ESTÁVEL
+
+// Escritos pelo núcleo 0 (shell), lidos pelo núcleo da Tarefa 3; cada float é
+// uma palavra alinhada, e um par trocado no meio de uma análise só vale nela
+static volatile float limiar_entrada = LIMIAR_ENTRADA_PADRAO;
+static volatile float limiar_saida = LIMIAR_SAIDA_PADRAO;
+
+static tendencia_t classificar(tendencia_t atual, float inclinacao) {
+    float entrada = limiar_entrada, saida = limiar_saida;
+    switch (atual) {
+        case TENDENCIA_SUBINDO:
+            if (inclinacao < saida) atual = TENDENCIA_ESTÁVEL;
+            break;
+        case TENDENCIA_CAINDO:
+            if (inclinacao > -saida) atual = TENDENCIA_ESTÁVEL;
+            break;
+        default:
+            break;
+    }
+    // Uma inversão forte troca direto, sem passar um ciclo por ESTÁVEL
+    if (inclinacao > entrada) return TENDENCIA_SUBINDO;
+    if (inclinacao < -entrada) return TENDENCIA_CAINDO;
+    return atual;
+}
+
+static uint32_t fila_frente(const fila_monotona_t *f) {
+    return f->seq[f->inicio];
+}
+
+static uint32_t fila_fundo(const fila_monotona_t *f) {
+    return f->seq[(f->inicio + f->n - 1) % TENDENCIA_JANELA];
+}
+
+// Acrescenta a leitura 'seq' (já no histórico). 'maximo' inverte a ordem:
+// descarta do fundo as que nunca mais serão extremo
+static void fila_acrescentar(fila_monotona_t *f, const int32_t *historico, uint32_t seq, bool maximo) {
+    int32_t y = historico[seq % TENDENCIA_JANELA];
+    while (f->n) {
+        int32_t v = historico[fila_fundo(f) % TENDENCIA_JANELA];
+        if (maximo ? v > y : v < y) break;
+        f->n--;
+    }
+    // Expira a frente que saiu da janela
+    if (f->n && seq - fila_frente(f) >= TENDENCIA_JANELA) {
+        f->inicio = (f->inicio + 1) % TENDENCIA_JANELA;
+        f->n--;
+    }
+    f->seq[(f->inicio + f->n) % TENDENCIA_JANELA] = seq;
+    f->n++;
+}
+
+const tarefa3_resultado_t *tarefa3_atualizar_canal(uint8_t canal, int32_t centi) {
+    if (canal >= TENDENCIA_CANAIS) canal = TENDENCIA_CANAL_PADRAO;
+    estado_tendencia_t *e = &estados[canal];
+    if (centi == CALIBRACAO_INVALIDA) return &e->resultado;   // Sem leitura: janela intacta
+
+    if (e->n == TENDENCIA_JANELA) {
+        // Remove a mais antiga (t = 0, não contribui para Σty) e
+        // desloca as demais uma posição: Σ(t-1)y = Σty - Σy
+        int32_t y0 = e->historico[e->mais_antiga];
+        e->soma_y -= y0;
+        e->soma_yy -= (int64_t)y0 * y0;
+        e->soma_ty -= e->soma_y;
+        e->mais_antiga = (e->mais_antiga + 1) % TENDENCIA_JANELA;
+        e->n--;
+    }
+
+    e->historico[(e->mais_antiga + e->n) % TENDENCIA_JANELA] = centi;
+    fila_acrescentar(&e->fila_min, e->historico, e->sequencia, false);
+    fila_acrescentar(&e->fila_max, e->historico, e->sequencia, true);
+    e->sequencia++;
+    e->soma_ty += (int64_t)e->n * centi;
+    e->soma_y += centi;
+    e->soma_yy += (int64_t)centi * centi;
+    e->n++;
+
+    float y = centi / 100.0f;
+    e->ema = (e->n == 1) ? y : e->ema + (y - e->ema) / (1 << EMA_DESLOCAMENTO);
+
+    // Σt e Σt² de t = 0..n-1 em forma fechada
+    int64_t nn = e->n;
+    int64_t soma_t = nn * (nn - 1) / 2;
+    int64_t soma_tt = (nn - 1) * nn * (2 * nn - 1) / 6;
+
+    int64_t sxx = nn * soma_tt - soma_t * soma_t;
+    int64_t sxy = nn * e->soma_ty - soma_t * e->soma_y;
+    int64_t syy = nn * e->soma_yy - e->soma_y * e->soma_y;
+
+    tarefa3_resultado_t *r = &e->resultado;
+    r->amostras = (uint8_t)e->n;
+    r->media_movel = e->ema;
+    r->minimo_centi = e->historico[fila_frente(&e->fila_min) % TENDENCIA_JANELA];
+    r->maximo_centi = e->historico[fila_frente(&e->fila_max) % TENDENCIA_JANELA];
+    r->inclinacao = sxx ? (float)sxy / (float)sxx / 100.0f : 0.0f;
+    r->variancia = e->n > 1 ? (float)syy / (float)(nn * (nn - 1)) / 10000.0f : 0.0f;
+    r->tendencia = e->n < AMOSTRAS_MINIMAS
+                 ? TENDENCIA_ESTÁVEL
+                 : classificar(r->tendencia, r->inclinacao);
+    return r;
+}
+
+const tarefa3_resultado_t *tarefa3_resultado_canal(uint8_t canal) {
+    if (canal >= TENDENCIA_CANAIS) canal = TENDENCIA_CANAL_PADRAO;
+    return &estados[canal].resultado;
+}
+
+void tarefa3_atualizar_canais(const int32_t centi[], uint8_t mascara) {
+    for (uint8_t c = 0; c < TENDENCIA_CANAIS; c++) {
+        if (mascara & (1u << c)) tarefa3_atualizar_canal(c, centi[c]);
+    }
+}
+
+const tarefa3_resultado_t *tarefa3_atualizar(int32_t centi) {
+    return tarefa3_atualizar_canal(TENDENCIA_CANAL_PADRAO, centi);
+}
+
+const tarefa3_resultado_t *tarefa3_resultado(void) {
+    return tarefa3_resultado_canal(TENDENCIA_CANAL_PADRAO);
+}
+
+void tarefa3_definir_limiares(float entrada, float saida) {
+    if (entrada < 0.0f) entrada = -entrada;
+    if (saida < 0.0f) saida = -saida;
+    if (saida > entrada) saida = entrada;   // Histerese nunca invertida
+    limiar_entrada = entrada;
+    limiar_saida = saida;
+}
+
+void tarefa3_limiares(float *entrada, float *saida) {
+    *entrada = limiar_entrada;
+    *saida = limiar_saida;
+}
+
+tendencia_t tarefa3_analisa_tendencia(float atual) {
+    return tarefa3_atualizar(lroundf(atual * 100.0f))->tendencia;
+}
+
+const char* tendencia_para_texto(tendencia_t t) {
+    switch (t) {
+        case TENDENCIA_SUBINDO:  return "SUBINDO";
+        case TENDENCIA_CAINDO:   return "CAINDO";
+        default:                 return "ESTAVEL";
+    }
 }
\ No newline at end of file
@@ -1,54 +1,122 @@
-/**
- * ------------------------------------------------------------
- *  Arquivo: tarefa3_tendencia.h
- *  Projeto: TempCycleDMA
- * ------------------------------------------------------------
- *  Descrição:
- *      Este cabeçalho define a interface da Tarefa 3 do
- *      executor cíclico: análise da tendência da temperatura.
- *
- *      Fornece:
- *        - Enumeração `tendencia_t` com os três estados possíveis
- *        - Função para determinar a tendência com base na temperatura atual
- *        - Função para converter a tendência em texto
- *
- *  
- *  Data: 12/05/2025
- * ------------------------------------------------------------
- */
-
-#ifndef TAREFA3_TENDENCIA_H
-#define TAREFA3_TENDENCIA_H
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-// Enumeração da tendência térmica
-typedef enum {
-    TENDENCIA_ESTÁVEL,
-    TENDENCIA_SUBINDO,
-    TENDENCIA_CAINDO
-} tendencia_t;
-
-/**
- * @brief Analisa a tendência com base na temperatura atual e anterior.
- *
- * @param atual Temperatura atual (ºC)
- * @return tendência identificada
- */
-tendencia_t tarefa3_analisa_tendencia(float atual);
-
-/**
- * @brief Converte a tendência para texto ("SUBINDO", "CAINDO", "ESTÁVEL").
- *
- * @param t Valor do tipo tendencia_t
- * @return Ponteiro para string correspondente
- */
-const char* tendencia_para_texto(tendencia_t t);
-
-#ifdef __cplusplus
-}
-#endif
-
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: tarefa3_tendencia.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Este cabeçalho define a interface da Tarefa 3 do
+ *      executor cíclico: análise da tendência da temperatura.
+ *
+ *      Fornece:
+ *        - Enumeração `tendencia_t` com os três estados possíveis
+ *        - Função para determinar a tendência com base na temperatura atual
+ *        - Resultado completo (inclinação, variância, EMA) da janela
+ *        - Função para converter a tendência em texto
+ *
+ *  
+ *  Data: 12/05/2025
+ * ------------------------------------------------------------
+ */
+
+#ifndef TAREFA3_TENDENCIA_H
+#define TAREFA3_TENDENCIA_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TENDENCIA_JANELA 16   // Leituras no histórico da regressão
+#define TENDENCIA_CANAIS 5    // Um estado por entrada do ADC
+#define TENDENCIA_CANAL_PADRAO 4   // Estado usado pela interface de canal único
+
+// Enumeração da tendência térmica
+typedef enum {
+    TENDENCIA_ESTÁVEL,
+    TENDENCIA_SUBINDO,
+    TENDENCIA_CAINDO
+} tendencia_t;
+
+// Resultado completo da análise sobre a janela de leituras
+typedef struct {
+    tendencia_t tendencia;    // Classificação com histerese
+    float inclinacao;         // Mínimos quadrados (°C por leitura)
+    float variancia;          // Variância das leituras na janela (°C²)
+    float media_movel;        // EMA das leituras (°C)
+    int32_t minimo_centi;     // Menor leitura na janela (centésimos de °C)
+    int32_t maximo_centi;     // Maior leitura na janela (centésimos de °C)
+    uint8_t amostras;         // Leituras na janela (até TENDENCIA_JANELA)
+} tarefa3_resultado_t;
+
+/**
+ * @brief Analisa a tendência com base na temperatura atual e no histórico.
+ *
+ * @param atual Temperatura atual (ºC)
+ * @return tendência identificada
+ */
+tendencia_t tarefa3_analisa_tendencia(float atual);
+
+/**
+ * @brief Acrescenta uma leitura ao histórico e recalcula a análise em O(1).
+ *
+ * @param centi Temperatura atual (centésimos de ºC)
+ * @return Resultado atualizado (válido até a próxima chamada)
+ */
+const tarefa3_resultado_t *tarefa3_atualizar(int32_t centi);
+
+/**
+ * @brief Resultado da última análise.
+ */
+const tarefa3_resultado_t *tarefa3_resultado(void);
+
+/**
+ * @brief Como tarefa3_atualizar(), sobre o estado de um canal do ADC.
+ *
+ * Uma leitura CALIBRACAO_INVALIDA não entra na janela: devolve a última
+ * análise do canal.
+ */
+const tarefa3_resultado_t *tarefa3_atualizar_canal(uint8_t canal, int32_t centi);
+
+/**
+ * @brief Resultado da última análise de um canal.
+ */
+const tarefa3_resultado_t *tarefa3_resultado_canal(uint8_t canal);
+
+/**
+ * @brief Atualiza o estado de cada canal presente na máscara.
+ *
+ * @param centi Temperatura por canal (centésimos de ºC), indexada pelo canal
+ * @param mascara Bit i ligado = canal i
+ */
+void tarefa3_atualizar_canais(const int32_t centi[], uint8_t mascara);
+
+/**
+ * @brief Troca os limiares da histerese (°C por leitura).
+ *
+ * 'saida' é limitado a 'entrada'. Vale a partir da próxima análise,
+ * para todos os canais.
+ *
+ * @param entrada Inclinação para entrar em SUBINDO/CAINDO
+ * @param saida Inclinação abaixo da qual volta a ESTÁVEL
+ */
+void tarefa3_definir_limiares(float entrada, float saida);
+
+/**
+ * @brief Limiares em uso (°C por leitura).
+ */
+void tarefa3_limiares(float *entrada, float *saida);
+
+/**
+ * @brief Converte a tendência para texto ("SUBINDO", "CAINDO", "ESTÁVEL").
+ *
+ * @param t Valor do tipo tendencia_t
+ * @return Ponteiro para string correspondente
+ */
+const char* tendencia_para_texto(tendencia_t t);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif  // TAREFA3_TENDENCIA_H
\ No newline at end of file
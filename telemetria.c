@@ -0,0 +1,66 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: telemetria.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Fila de registros de telemetria (um produtor, um
+ *      consumidor) e drenagem para a CDC da USB.
+ *
+ *      A drenagem envia só os registros que cabem inteiros no
+ *      FIFO de TX, cada um em uma escrita de 'usb_binario.c'
+ *      (sob o mutex do stdio_usb), de modo que um registro
+ *      nunca fica pela metade no fluxo. Sem host conectado nada
+ *      é enviado e a fila apenas enche e descarta.
+ *
+ *  Relacionamento:
+ *      - Os registros são montados por main.c a cada ciclo
+ *      - A drenagem é uma entrada da tabela do escalonador
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "telemetria.h"
+#include "usb_binario.h"
+#include "fletcher16.h"
+
+static telemetria_registro_t itens[TELEMETRIA_TAMANHO_FILA];
+static volatile uint32_t cabeca = 0;       // Próximo registro a escrever
+static volatile uint32_t cauda = 0;        // Próximo registro a enviar
+static uint32_t descartados = 0;
+static uint8_t sequencia = 0;
+
+bool telemetria_registrar(telemetria_registro_t *r) {
+    r->sincronismo = TELEMETRIA_SINCRONISMO;
+    r->versao = TELEMETRIA_VERSAO;
+    r->sequencia = sequencia++;
+    r->descartados = descartados > 255 ? 255 : (uint8_t)descartados;
+    r->verificacao = fletcher16(r, sizeof(*r) - sizeof(r->verificacao));
+
+    uint32_t c = cabeca;
+    if (c - cauda == TELEMETRIA_TAMANHO_FILA) {
+        descartados++;
+        return false;
+    }
+
+    itens[c % TELEMETRIA_TAMANHO_FILA] = *r;
+    __dmb();            // Conteúdo visível antes do novo índice
+    cabeca = c + 1;
+    return true;
+}
+
+void telemetria_drenar(void) {
+    while (cauda != cabeca && usb_binario_livre() >= sizeof(telemetria_registro_t)) {
+        __dmb();        // Índice lido antes do conteúdo
+        usb_binario_escrever(&itens[cauda % TELEMETRIA_TAMANHO_FILA], sizeof(telemetria_registro_t));
+        cauda = cauda + 1;
+    }
+}
+
+uint32_t telemetria_descartados(void) {
+    return descartados;
+}
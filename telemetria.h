@@ -0,0 +1,80 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: telemetria.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Telemetria binária de cada ciclo pela USB. Os registros
+ *      são gravados em uma fila circular sem trava e drenados
+ *      para a CDC apenas quando há espaço de transmissão, de
+ *      modo que o custo e o jitter da saída não entram no laço
+ *      de medição. Com a fila cheia o registro é descartado e
+ *      contado, nunca bloqueia.
+ *
+ *      Formato (little-endian, 32 bytes, sem preenchimento):
+ *        u16 sincronismo  0x5AA5
+ *        u8  versao       TELEMETRIA_VERSAO
+ *        u8  sequencia    incrementa a cada registro gerado
+ *        u32 timestamp_us fim da janela (time_us_32)
+ *        u16 media_bruta  código médio do ADC × 16
+ *        i16 media_centi  temperatura em centésimos de °C
+ *                         (TELEMETRIA_CENTI_INVALIDA: sem leitura)
+ *        u8  tendencia    tendencia_t
+ *        u8  descartados  registros perdidos por fila cheia (satura em 255)
+ *        u32 t1_us .. t4_us  duração de cada tarefa
+ *        u16 fletcher16   sobre os 30 bytes anteriores
+ *
+ *      O decodificador é tools/decodificar_telemetria.py; o
+ *      sincronismo e a soma de verificação permitem ressincronizar
+ *      se houver texto (ex.: estatísticas) no mesmo fluxo.
+ *
+ *  
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef TELEMETRIA_H
+#define TELEMETRIA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TELEMETRIA_SINCRONISMO 0x5AA5
+#define TELEMETRIA_VERSAO      1
+#define TELEMETRIA_TAMANHO_FILA 32   // Registros; potência de 2
+#define TELEMETRIA_CENTI_INVALIDA INT16_MIN   // Canal principal sem temperatura (CALIBRACAO_INVALIDA)
+
+typedef struct __attribute__((packed)) {
+    uint16_t sincronismo;
+    uint8_t versao;
+    uint8_t sequencia;
+    uint32_t timestamp_us;
+    uint16_t media_bruta_q4;
+    int16_t media_centi;
+    uint8_t tendencia;
+    uint8_t descartados;
+    uint32_t tempo_us[4];
+    uint16_t verificacao;
+} telemetria_registro_t;
+
+_Static_assert(sizeof(telemetria_registro_t) == 32, "registro de telemetria deve ter 32 bytes");
+
+/**
+ * @brief Preenche sincronismo, versão, sequência e verificação e
+ *        enfileira o registro. Não bloqueia.
+ *
+ * @return false se a fila estiver cheia (registro descartado).
+ */
+bool telemetria_registrar(telemetria_registro_t *r);
+
+/**
+ * @brief Envia à USB o que couber no espaço livre de transmissão.
+ */
+void telemetria_drenar(void);
+
+/**
+ * @brief Registros descartados por fila cheia desde o início.
+ */
+uint32_t telemetria_descartados(void);
+
+#endif  // TELEMETRIA_H
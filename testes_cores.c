@@ -1,50 +1,57 @@
-#include "LabNeoPixel/neopixel_driver.h"
-#include "pico/stdlib.h"
-#include "testes_cores.h"
-#include "LabNeoPixel/efeitos.h"
-
-typedef struct {
-    uint8_t r, g, b;
-} CorRGB;
-
-void preencher_matriz_com_cores(void) {
-    const CorRGB cores[] = {
-        {COR_MIN, COR_APAGA, COR_APAGA},  // Vermelho
-        {COR_APAGA, COR_MIN, COR_APAGA},  // Verde
-        {COR_APAGA, COR_APAGA, COR_MIN},  // Azul
-        {COR_MIN, COR_MIN, COR_APAGA},    // Amarelo
-        {COR_APAGA, COR_MIN, COR_MIN},    // Ciano
-        {COR_MIN, COR_APAGA, COR_MIN},    // Magenta
-        {COR_MIN, COR_MIN, COR_MIN}       // Branco suave
-    };
-
-    const uint8_t total_cores = sizeof(cores) / sizeof(cores[0]);
-
-    for (uint8_t i = 0; i < total_cores; ++i) {
-        npSetAll(cores[i].r, cores[i].g, cores[i].b);
-        npWrite();
-        sleep_ms(700);
-    }
-}
-
-void testar_fileiras_colunas(void) {
-    // Fileiras de cima para baixo em vermelho suave
-    for (uint8_t y = 0; y < NUM_LINHAS; y++) {
-        npClear();
-        acenderFileira(y, COR_MIN, COR_APAGA, COR_APAGA); // vermelho
-        npWrite();
-        sleep_ms(250);
-    }
-
-    sleep_ms(500);
-
-    // Colunas da esquerda para a direita em azul suave
-    for (uint8_t x = 0; x < NUM_COLUNAS; x++) {
-        npClear();
-        acenderColuna(x, COR_APAGA, COR_APAGA, COR_MIN); // azul
-        npWrite();
-        sleep_ms(250);
-    }
-
-    sleep_ms(500);
-}
+#include "LabNeoPixel/neopixel_driver.h"
+#include "pico/stdlib.h"
+#include "testes_cores.h"
+#include "LabNeoPixel/efeitos.h"
+
+typedef struct {
+    uint8_t r, g, b;
+} CorRGB;
+
+static const CorRGB cores[] = {
+    {COR_MIN, COR_APAGA, COR_APAGA},  // Vermelho
+    {COR_APAGA, COR_MIN, COR_APAGA},  // Verde
+    {COR_APAGA, COR_APAGA, COR_MIN},  // Azul
+    {COR_MIN, COR_MIN, COR_APAGA},    // Amarelo
+    {COR_APAGA, COR_MIN, COR_MIN},    // Ciano
+    {COR_MIN, COR_APAGA, COR_MIN},    // Magenta
+    {COR_MIN, COR_MIN, COR_MIN}       // Branco suave
+};
+
+// Um quadro por cor, 700 ms cada (parâmetros de cor ignorados)
+uint32_t quadro_matriz_com_cores(uint16_t passo, const efeito_param_t *p) {
+    (void)p;
+    const uint8_t total_cores = sizeof(cores) / sizeof(cores[0]);
+
+    if (passo >= total_cores) return 0;
+    npSetAll(cores[passo].r, cores[passo].g, cores[passo].b);
+    return 700;
+}
+
+// Fileiras de cima para baixo em vermelho suave, pausa, colunas da
+// esquerda para a direita em azul suave, pausa
+uint32_t quadro_fileiras_colunas(uint16_t passo, const efeito_param_t *p) {
+    (void)p;
+    npClear();
+
+    if (passo < NUM_LINHAS) {
+        npSetFileira(passo, 0, NUM_COLUNAS, COR_MIN, COR_APAGA, COR_APAGA); // vermelho
+        // A última fileira fica acesa durante a pausa
+        return passo == NUM_LINHAS - 1 ? 250 + 500 : 250;
+    }
+
+    passo -= NUM_LINHAS;
+    if (passo < NUM_COLUNAS) {
+        npSetColuna(passo, 0, NUM_LINHAS, COR_APAGA, COR_APAGA, COR_MIN); // azul
+        return passo == NUM_COLUNAS - 1 ? 250 + 500 : 250;
+    }
+
+    return 0;
+}
+
+void preencher_matriz_com_cores(void) {
+    efeitoExecutar(quadro_matriz_com_cores, 0, 0, 0, 0);
+}
+
+void testar_fileiras_colunas(void) {
+    efeitoExecutar(quadro_fileiras_colunas, 0, 0, 0, 0);
+}
@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""
+Decodifica a telemetria binária do TempCycleDMA (telemetria.h).
+
+Cada registro tem 32 bytes little-endian:
+
+    u16 sincronismo (0x5AA5)  u8 versao  u8 sequencia
+    u32 timestamp_us  u16 media_bruta (ADC x 16)  i16 media_centi
+    u8 tendencia  u8 descartados  u32 t1_us t2_us t3_us t4_us
+    u16 fletcher16 dos 30 bytes anteriores
+
+media_centi = -32768 indica um ciclo sem temperatura (termistor aberto
+ou em curto): temp_c sai vazio.
+
+Bytes que não formam um registro válido (ex.: texto das estatísticas
+no mesmo fluxo) são ignorados até o próximo sincronismo. A saída é CSV
+em stdout; lacunas na sequência são avisadas em stderr.
+
+Uso: decodificar_telemetria.py [porta_serial | arquivo | -]
+     (porta serial requer pyserial; sem argumento lê stdin)
+"""
+
+import struct
+import sys
+
+FORMATO = struct.Struct("<HBBIHhBB4IH")
+SINCRONISMO = 0x5AA5
+VERSAO = 1
+CENTI_INVALIDA = -32768
+TENDENCIAS = {0: "estavel", 1: "subindo", 2: "caindo"}
+
+
+def fletcher16(dados):
+    s1 = s2 = 0
+    for b in dados:
+        s1 = (s1 + b) % 255
+        s2 = (s2 + s1) % 255
+    return (s2 << 8) | s1
+
+
+def abrir(origem):
+    if origem in (None, "-"):
+        return sys.stdin.buffer
+    if origem.startswith("/dev/") or origem.upper().startswith("COM"):
+        import serial  # pyserial
+        return serial.Serial(origem, 115200, timeout=1)
+    return open(origem, "rb")
+
+
+def registros(fluxo):
+    buf = bytearray()
+    while True:
+        bloco = fluxo.read(256)
+        if not bloco:
+            if not hasattr(fluxo, "in_waiting"):  # Arquivo ou stdin terminou
+                return
+            continue
+        buf += bloco
+        while len(buf) >= FORMATO.size:
+            i = buf.find(struct.pack("<H", SINCRONISMO))
+            if i < 0:
+                del buf[:-1]
+                break
+            del buf[:i]
+            if len(buf) < FORMATO.size:
+                break
+            bruto = bytes(buf[:FORMATO.size])
+            campos = FORMATO.unpack(bruto)
+            if campos[1] != VERSAO or fletcher16(bruto[:-2]) != campos[-1]:
+                del buf[:1]  # Falso sincronismo
+                continue
+            del buf[:FORMATO.size]
+            yield campos
+
+
+def main():
+    origem = sys.argv[1] if len(sys.argv) > 1 else None
+    print("seq,timestamp_us,adc_medio,temp_c,tendencia,descartados,t1_us,t2_us,t3_us,t4_us")
+    anterior = None
+    for (_, _, seq, ts, bruta, centi, tend, desc, t1, t2, t3, t4, _) in registros(abrir(origem)):
+        if anterior is not None and seq != (anterior + 1) & 0xFF:
+            print(f"# lacuna: {(seq - anterior - 1) & 0xFF} registro(s)", file=sys.stderr)
+        anterior = seq
+        temp = "" if centi == CENTI_INVALIDA else f"{centi / 100:.2f}"
+        print(f"{seq},{ts},{bruta / 16:.2f},{temp},{TENDENCIAS.get(tend, tend)},"
+              f"{desc},{t1},{t2},{t3},{t4}", flush=True)
+
+
+if __name__ == "__main__":
+    main()
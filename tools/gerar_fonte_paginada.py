@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""
+Converte a fonte grande (inc/font_big_logo_data.c) para o formato de
+páginas do SSD1306.
+
+Os bitmaps originais são 16 x 32, por linhas: 2 bytes por linha, bit 7
+do primeiro byte = coluna 0. No SSD1306 a memória é organizada em
+páginas de 8 linhas, um byte por coluna (bit 0 = linha de cima da
+página). O glifo convertido tem 4 páginas x 16 colunas = 64 bytes:
+
+    glifo[pagina * 16 + coluna], bit k = pixel (pagina * 8 + k, coluna)
+
+Cada tabela 'nome[64]' da entrada gera 'nome_pag[64]' na saída.
+
+Uso: gerar_fonte_paginada.py <font_big_logo_data.c> <saida.c>
+"""
+
+import re
+import sys
+
+LARGURA = 16
+ALTURA = 32
+PAGINAS = ALTURA // 8
+
+
+def ler_glifos(texto):
+    padrao = re.compile(r"const\s+uint8_t\s+(\w+)\s*\[\s*64\s*\]\s*=\s*\{([^}]*)\}", re.S)
+    glifos = []
+    for nome, corpo in padrao.findall(texto):
+        valores = [int(v, 0) for v in re.findall(r"0x[0-9A-Fa-f]+|\d+", corpo)]
+        if len(valores) != LARGURA * ALTURA // 8:
+            raise SystemExit(f"{nome}: esperados 64 bytes, encontrados {len(valores)}")
+        glifos.append((nome, valores))
+    return glifos
+
+
+def paginar(linhas):
+    saida = [0] * (PAGINAS * LARGURA)
+    for linha in range(ALTURA):
+        for coluna in range(LARGURA):
+            byte = linhas[linha * 2 + coluna // 8]
+            if (byte >> (7 - coluna % 8)) & 1:
+                saida[(linha // 8) * LARGURA + coluna] |= 1 << (linha % 8)
+    return saida
+
+
+def main():
+    if len(sys.argv) != 3:
+        raise SystemExit(__doc__)
+
+    with open(sys.argv[1], encoding="utf-8") as f:
+        glifos = ler_glifos(f.read())
+
+    partes = [
+        "// Gerado por tools/gerar_fonte_paginada.py a partir de font_big_logo_data.c.",
+        "// Não editar: alterações devem ser feitas na fonte original.",
+        "",
+        '#include "font_big_paginada.h"',
+        "",
+    ]
+    for nome, linhas in glifos:
+        dados = paginar(linhas)
+        partes.append(f"const uint8_t {nome}_pag[64] = {{")
+        for p in range(PAGINAS):
+            trecho = dados[p * LARGURA:(p + 1) * LARGURA]
+            sep = "," if p < PAGINAS - 1 else ""
+            partes.append("  " + ",".join(f"0x{b:02X}" for b in trecho) + sep)
+        partes.append("};")
+        partes.append("")
+
+    with open(sys.argv[2], "w", encoding="utf-8", newline="\n") as f:
+        f.write("\n".join(partes))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""
+Gera a tabela (x, y) -> índice da matriz de NeoPixels para uma
+geometria e uma ligação dadas.
+
+Coordenadas lógicas: x = coluna da esquerda para a direita, y = linha
+de cima para baixo. O índice é a posição do LED na fita, a partir do
+canto 'origem':
+
+    sentido     linhas: a fita percorre uma linha inteira e passa à
+                seguinte; colunas: percorre uma coluna inteira
+    serpentina  1: cada trecho volta no sentido oposto ao anterior
+                (ligação em zigue-zague); 0: todos no mesmo sentido
+
+A placa BitDogLab (5 x 5) usa origem inferior_direito, linhas e
+serpentina 1.
+
+Saída: np_layout[NUM_LINHAS][NUM_COLUNAS] e np_espiral[LED_COUNT]
+(índices em espiral horária a partir do canto superior esquerdo),
+ambas const, declaradas em LabNeoPixel/neopixel_driver.h.
+
+Uso: gerar_layout_matriz.py <colunas> <linhas> <origem> <sentido> <serpentina> <saida.c>
+     origem: superior_esquerdo, superior_direito, inferior_esquerdo, inferior_direito
+"""
+
+import sys
+
+ORIGENS = ("superior_esquerdo", "superior_direito", "inferior_esquerdo", "inferior_direito")
+SENTIDOS = ("linhas", "colunas")
+
+
+def indice(x, y, colunas, linhas, origem, sentido, serpentina):
+    # Posição contada a partir do canto de origem
+    dx = colunas - 1 - x if origem.endswith("direito") else x
+    dy = linhas - 1 - y if origem.startswith("inferior") else y
+    if sentido == "linhas":
+        trecho, pos, tamanho = dy, dx, colunas
+    else:
+        trecho, pos, tamanho = dx, dy, linhas
+    if serpentina and trecho % 2:
+        pos = tamanho - 1 - pos
+    return trecho * tamanho + pos
+
+
+def espiral(colunas, linhas):
+    topo, base, esq, dir_ = 0, linhas - 1, 0, colunas - 1
+    ordem = []
+    while topo <= base and esq <= dir_:
+        ordem += [(x, topo) for x in range(esq, dir_ + 1)]
+        ordem += [(dir_, y) for y in range(topo + 1, base + 1)]
+        if topo < base:
+            ordem += [(x, base) for x in range(dir_ - 1, esq - 1, -1)]
+        if esq < dir_:
+            ordem += [(esq, y) for y in range(base - 1, topo, -1)]
+        topo, base, esq, dir_ = topo + 1, base - 1, esq + 1, dir_ - 1
+    return ordem
+
+
+def main():
+    if len(sys.argv) != 7:
+        raise SystemExit(__doc__)
+
+    colunas, linhas = int(sys.argv[1]), int(sys.argv[2])
+    origem, sentido = sys.argv[3], sys.argv[4]
+    serpentina = sys.argv[5].upper() not in ("0", "OFF", "FALSE", "NO", "")
+    if colunas < 1 or linhas < 1 or colunas * linhas > 0xFFFF:
+        raise SystemExit(f"geometria inválida: {colunas} x {linhas}")
+    if origem not in ORIGENS:
+        raise SystemExit(f"origem inválida: {origem} (use {', '.join(ORIGENS)})")
+    if sentido not in SENTIDOS:
+        raise SystemExit(f"sentido inválido: {sentido} (use {', '.join(SENTIDOS)})")
+
+    mapa = [[indice(x, y, colunas, linhas, origem, sentido, serpentina)
+             for x in range(colunas)] for y in range(linhas)]
+    assert sorted(i for linha in mapa for i in linha) == list(range(colunas * linhas))
+
+    partes = [
+        "// Gerado por tools/gerar_layout_matriz.py: "
+        f"{colunas} x {linhas}, origem {origem}, {sentido}, serpentina {int(serpentina)}.",
+        "// Não editar: a geometria vem do CMakeLists.txt (NP_COLUNAS, NP_LINHAS, ...).",
+        "",
+        '#include "neopixel_driver.h"',
+        "",
+        f"_Static_assert(NUM_COLUNAS == {colunas} && NUM_LINHAS == {linhas},",
+        '               "geometria de neopixel_driver.h difere da tabela gerada");',
+        "",
+        "const np_indice_t np_layout[NUM_LINHAS][NUM_COLUNAS] = {",
+    ]
+    for y, linha in enumerate(mapa):
+        sep = "," if y < linhas - 1 else ""
+        partes.append("  {" + ",".join(str(i) for i in linha) + "}" + sep)
+    partes.append("};")
+    partes.append("")
+
+    ordem = [mapa[y][x] for x, y in espiral(colunas, linhas)]
+    partes.append("const np_indice_t np_espiral[LED_COUNT] = {")
+    for k in range(0, len(ordem), 16):
+        trecho = ordem[k:k + 16]
+        sep = "," if k + 16 < len(ordem) else ""
+        partes.append("  " + ",".join(str(i) for i in trecho) + sep)
+    partes.append("};")
+    partes.append("")
+
+    with open(sys.argv[6], "w", encoding="utf-8", newline="\n") as f:
+        f.write("\n".join(partes))
+
+
+if __name__ == "__main__":
+    main()
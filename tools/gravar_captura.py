@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""
+Grava e decodifica a captura das amostras brutas do ADC do TempCycleDMA
+(captura.h).
+
+Com uma porta serial, envia 'c', grava pelo tempo pedido e envia 'c' de
+novo para desligar; com um arquivo (ou stdin), decodifica uma gravação
+já feita. '-b arquivo' guarda também o fluxo bruto.
+
+Cada bloco do ping-pong chega em trechos little-endian:
+
+    u16 sincronismo (0x5CC5)  u8 versao  u8 amostras
+    u32 bloco  u16 deslocamento  u8 canais  u8 fase
+    u32 fim_us  u32 perdidos
+    amostras x 12 bits, pares em 3 bytes (a[7:0], a[11:8] | b[3:0] << 4,
+    b[11:4]); uma amostra ímpar no fim ocupa 2 bytes
+    u16 fletcher16 do cabeçalho e das amostras
+
+O canal de cada amostra vem da sequência do round-robin (canais da
+máscara em ordem crescente) a partir de 'fase'. Trechos com soma errada
+(sobrescritos pelo DMA durante o envio) e texto no mesmo fluxo são
+ignorados. A saída é CSV em stdout, só com blocos completos (do tamanho
+mais comum na gravação); blocos incompletos e os perdidos na placa são
+avisados em stderr.
+
+Uso: gravar_captura.py [-s segundos] [-b bruto.bin] [porta_serial | arquivo | -]
+     (porta serial requer pyserial; sem argumento lê stdin)
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+CABECALHO = struct.Struct("<HBBIHBBII")
+SINCRONISMO = 0x5CC5
+VERSAO = 1
+
+
+def fletcher16(dados):
+    s1 = s2 = 0
+    for b in dados:
+        s1 = (s1 + b) % 255
+        s2 = (s2 + s1) % 255
+    return (s2 << 8) | s1
+
+
+def capturar(origem, segundos):
+    if origem in (None, "-"):
+        return sys.stdin.buffer.read()
+    if origem.startswith("/dev/") or origem.upper().startswith("COM"):
+        import serial  # pyserial
+        porta = serial.Serial(origem, 115200, timeout=0.2)
+        porta.reset_input_buffer()
+        porta.write(b"c")
+        dados = bytearray()
+        fim = time.monotonic() + segundos
+        while time.monotonic() < fim:
+            dados += porta.read(65536)
+        porta.write(b"c")
+        time.sleep(0.5)
+        dados += porta.read(65536)
+        return bytes(dados)
+    with open(origem, "rb") as f:
+        return f.read()
+
+
+def desempacotar(bruto, n):
+    amostras = []
+    for i in range(0, n - 1, 2):
+        b0, b1, b2 = bruto[i // 2 * 3:i // 2 * 3 + 3]
+        amostras += [b0 | (b1 & 0x0F) << 8, b1 >> 4 | b2 << 4]
+    if n % 2:
+        k = n // 2 * 3
+        amostras.append(bruto[k] | (bruto[k + 1] & 0x0F) << 8)
+    return amostras
+
+
+def trechos(dados):
+    marca = struct.pack("<H", SINCRONISMO)
+    i = dados.find(marca)
+    while 0 <= i <= len(dados) - CABECALHO.size:
+        campos = CABECALHO.unpack_from(dados, i)
+        n = campos[2]
+        fim = i + CABECALHO.size + (3 * n + 1) // 2
+        if campos[1] == VERSAO and fim + 2 <= len(dados):
+            soma, = struct.unpack_from("<H", dados, fim)
+            if fletcher16(dados[i:fim]) == soma:
+                yield campos, desempacotar(dados[i + CABECALHO.size:fim], n)
+                i = dados.find(marca, fim + 2)
+                continue
+        i = dados.find(marca, i + 1)  # Falso sincronismo ou trecho corrompido
+
+
+def main():
+    args = argparse.ArgumentParser(description="Captura das amostras brutas do ADC")
+    args.add_argument("origem", nargs="?")
+    args.add_argument("-s", "--segundos", type=float, default=5.0)
+    args.add_argument("-b", "--bruto")
+    a = args.parse_args()
+
+    dados = capturar(a.origem, a.segundos)
+    if a.bruto:
+        with open(a.bruto, "wb") as f:
+            f.write(dados)
+
+    print("bloco,amostra,canal,codigo")
+    blocos = {}
+    perdidos = 0
+    for (_, _, n, bloco, desl, canais, fase, _, perd), amostras in trechos(dados):
+        blocos.setdefault(bloco, (canais, fase if desl == 0 else None, {}))[2][desl] = amostras
+        perdidos = max(perdidos, perd)
+
+    # O cabeçalho não traz o tamanho do bloco: vale o mais comum na gravação
+    totais = {}
+    for _, _, partes in blocos.values():
+        total = max(d + len(p) for d, p in partes.items())
+        totais[total] = totais.get(total, 0) + 1
+    tamanho = max(totais, key=totais.get) if totais else 0
+
+    incompletos = 0
+    for bloco in sorted(blocos):
+        canais, fase, partes = blocos[bloco]
+        seq = [c for c in range(5) if canais >> c & 1] or [0]
+        amostras = []
+        for desl in sorted(partes):
+            if desl != len(amostras):
+                break
+            amostras += partes[desl]
+        if fase is None or len(amostras) != tamanho:
+            incompletos += 1
+            continue
+        for j, codigo in enumerate(amostras):
+            print(f"{bloco},{j},{seq[(fase + j) % len(seq)]},{codigo}")
+
+    print(f"# blocos: {len(blocos) - incompletos} completos, {incompletos} incompletos, "
+          f"{perdidos} perdidos na placa", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""
+Lê o histórico gravado na flash do TempCycleDMA (historico.h).
+
+Com uma porta serial, envia o comando 'h' e lê até a USB ficar em
+silêncio; com um arquivo (ou stdin), decodifica uma captura já feita.
+
+Cada página tem 256 bytes little-endian:
+
+    u16 magica (0x4853)  u16 fletcher16 dos 252 bytes seguintes
+    u32 sequencia
+    31 x { u32 timestamp_ms  i16 media_centi  u8 tendencia  u8 inicializacao }
+
+Posições com timestamp 0xFFFFFFFF não foram usadas. Bytes fora de uma
+página válida (telemetria ou texto no mesmo fluxo) são ignorados, e uma
+sequência repetida (a página em RAM enviada de novo depois de gravada)
+aparece uma só vez. A saída é CSV em stdout, da mais antiga para a mais
+recente; lacunas de sequência são avisadas em stderr.
+
+Uso: ler_historico.py [porta_serial | arquivo | -]
+     (porta serial requer pyserial; sem argumento lê stdin)
+"""
+
+import struct
+import sys
+import time
+
+CABECALHO = struct.Struct("<HHI")
+REGISTRO = struct.Struct("<IhBB")
+TAMANHO_PAGINA = 256
+REGISTROS_PAGINA = 31
+MAGICA = 0x4853
+VAZIO = 0xFFFFFFFF
+SILENCIO_S = 2.0
+TENDENCIAS = {0: "estavel", 1: "subindo", 2: "caindo"}
+
+
+def fletcher16(dados):
+    s1 = s2 = 0
+    for b in dados:
+        s1 = (s1 + b) % 255
+        s2 = (s2 + s1) % 255
+    return (s2 << 8) | s1
+
+
+def capturar(origem):
+    if origem in (None, "-"):
+        return sys.stdin.buffer.read()
+    if origem.startswith("/dev/") or origem.upper().startswith("COM"):
+        import serial  # pyserial
+        porta = serial.Serial(origem, 115200, timeout=0.2)
+        porta.reset_input_buffer()
+        porta.write(b"h")
+        dados = bytearray()
+        ultimo = time.monotonic()
+        while time.monotonic() - ultimo < SILENCIO_S:
+            bloco = porta.read(4096)
+            if bloco:
+                dados += bloco
+                ultimo = time.monotonic()
+        return bytes(dados)
+    with open(origem, "rb") as f:
+        return f.read()
+
+
+def paginas(dados):
+    marca = struct.pack("<H", MAGICA)
+    i = dados.find(marca)
+    while 0 <= i <= len(dados) - TAMANHO_PAGINA:
+        bruto = dados[i:i + TAMANHO_PAGINA]
+        _, verificacao, sequencia = CABECALHO.unpack_from(bruto)
+        if fletcher16(bruto[4:]) == verificacao:
+            yield sequencia, bruto
+            i = dados.find(marca, i + TAMANHO_PAGINA)
+        else:
+            i = dados.find(marca, i + 1)  # Falsa marca
+
+
+def main():
+    origem = sys.argv[1] if len(sys.argv) > 1 else None
+    print("sequencia,boot,timestamp_ms,temp_c,tendencia")
+    anterior = None
+    for sequencia, bruto in paginas(capturar(origem)):
+        if anterior is not None and sequencia == anterior:
+            continue
+        if anterior is not None and sequencia != (anterior + 1) & 0xFFFFFFFF:
+            print(f"# lacuna: sequencia {anterior} -> {sequencia}", file=sys.stderr)
+        anterior = sequencia
+        for k in range(REGISTROS_PAGINA):
+            ts, centi, tend, boot = REGISTRO.unpack_from(bruto, CABECALHO.size + k * REGISTRO.size)
+            if ts == VAZIO:
+                continue
+            print(f"{sequencia},{boot},{ts},{centi / 100:.2f},{TENDENCIAS.get(tend, tend)}")
+
+
+if __name__ == "__main__":
+    main()
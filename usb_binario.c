@@ -0,0 +1,32 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: usb_binario.c
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Escrita binária pela CDC através do driver do stdio_usb
+ *      (usb_binario.h).
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "tusb.h"
+#include "usb_binario.h"
+
+bool usb_binario_conectado(void) {
+    return stdio_usb_connected();
+}
+
+uint32_t usb_binario_livre(void) {
+    if (!stdio_usb_connected()) return 0;
+    return tud_cdc_write_available();
+}
+
+void usb_binario_escrever(const void *dados, uint32_t n) {
+    // O driver toma o mutex, escreve no FIFO, roda tud_task() e faz o flush
+    stdio_usb.out_chars((const char *)dados, (int)n);
+}
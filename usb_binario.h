@@ -0,0 +1,60 @@
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: usb_binario.h
+ *  Projeto: TempCycleDMA
+ * ------------------------------------------------------------
+ *  Descrição:
+ *      Escritor único dos fluxos binários pela CDC da USB
+ *      (telemetria, histórico e captura).
+ *
+ *      Os bytes passam pelo driver do stdio_usb (stdio_usb.
+ *      out_chars), que toma o mesmo mutex do printf e da
+ *      tarefa de fundo que roda tud_task() no IRQ de baixa
+ *      prioridade: uma escrita nunca corre com a outra no FIFO
+ *      de TX, e não passa pela tradução de '\n' do stdio.
+ *
+ *      O mutex vale por chamada: um registro ou trecho sai em
+ *      uma chamada só. Enquanto um fluxo binário está
+ *      ativo (histórico em envio, captura ligada, ou a
+ *      telemetria binária com o host conectado) nenhum printf
+ *      pode acontecer, nem no núcleo 1: o texto cairia entre
+ *      os bytes de um registro. Por isso a telemetria fica
+ *      suspensa durante o envio do histórico e a captura
+ *      (usb_livre em 'main.c'), e o texto das teclas sai antes
+ *      de o fluxo começar.
+ *
+ *  Relacionamento:
+ *      - 'telemetria.c', 'historico.c' e 'captura.c'.
+ *
+ *
+ *  Data: 14/10/2026
+ * ------------------------------------------------------------
+ */
+
+#ifndef USB_BINARIO_H
+#define USB_BINARIO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Indica se há host com a porta aberta.
+ */
+bool usb_binario_conectado(void);
+
+/**
+ * @brief Bytes que cabem agora no FIFO de TX (0 sem host conectado).
+ *
+ * Só a tarefa de fundo consome o FIFO enquanto não há printf, então o
+ * valor é um mínimo até a próxima escrita.
+ */
+uint32_t usb_binario_livre(void);
+
+/**
+ * @brief Escreve e envia 'n' bytes, sob o mutex do stdio_usb.
+ *
+ * Com n até usb_binario_livre() a chamada não espera pelo host.
+ */
+void usb_binario_escrever(const void *dados, uint32_t n);
+
+#endif  // USB_BINARIO_H